@@ -24,11 +24,15 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <mutex>
 #include <sstream>
+#include <set>
+#include <thread>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -202,7 +206,8 @@ S3D_CACHE::~S3D_CACHE()
 }
 
 
-SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr,
+                             bool aRenderDataOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -260,6 +265,17 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
             }
         }
 
+        // the entry may only hold render data read from the model cache; load the
+        // scene graph now that it is needed
+        if( !aRenderDataOnly && NULL == mi->second->sceneData
+                && NULL != mi->second->renderData && !loadCacheData( mi->second ) )
+        {
+            mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath, mi->second->pluginInfo );
+
+            if( NULL != mi->second->sceneData )
+                saveCacheData( mi->second );
+        }
+
         if( NULL != aCachePtr )
             *aCachePtr = mi->second;
 
@@ -267,7 +283,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
     }
 
     // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return checkCache( full3Dpath, aCachePtr, aRenderDataOnly );
 }
 
 
@@ -277,7 +293,8 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr,
+                                   bool aRenderDataOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -334,6 +351,10 @@ SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY**
 
     ep->SetSHA1( sha1sum );
 
+    // the model cache holds the render data only, which avoids building the scene graph
+    if( aRenderDataOnly && loadModelCacheData( ep ) )
+        return NULL;
+
     wxString bname = ep->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
@@ -437,7 +458,8 @@ bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
     if( NULL != aCacheItem->sceneData )
         S3D::DestroyNode( (SGNODE*) aCacheItem->sceneData );
 
-    aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), m_Plugins, checkTag );
+    aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), m_Plugins, checkTag,
+                                                         &aCacheItem->pluginInfo );
 
     if( NULL == aCacheItem->sceneData )
         return false;
@@ -500,6 +522,50 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
 }
 
 
+bool S3D_CACHE::loadModelCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    if( NULL != aCacheItem->renderData )
+        S3D::Destroy3DModel( &aCacheItem->renderData );
+
+    aCacheItem->renderData = S3D::ReadModelCache( fname.ToUTF8(), m_Plugins, checkTag );
+
+    if( NULL == aCacheItem->renderData )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] cannot load model cache file '%s'", fname );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool S3D_CACHE::saveModelCacheData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( NULL == aCacheItem || NULL == aCacheItem->renderData )
+        return false;
+
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    return S3D::WriteModelCache( fname.ToUTF8(), aCacheItem->renderData,
+                                 aCacheItem->pluginInfo.c_str() );
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -654,7 +720,10 @@ void S3D_CACHE::ClosePlugins()
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
 {
     S3D_CACHE_ENTRY* cp = NULL;
-    SCENEGRAPH* sp = load( aModelFileName, &cp );
+    SCENEGRAPH* sp = load( aModelFileName, &cp, true );
+
+    if( cp && cp->renderData )
+        return cp->renderData;
 
     if( !sp )
         return NULL;
@@ -668,16 +737,150 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
         return NULL;
     }
 
-    if( cp->renderData )
-        return cp->renderData;
-
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( mp )
+        saveModelCacheData( cp );
+
     return mp;
 }
 
 
+void S3D_CACHE::PreloadModels( const std::vector<wxString>& aModelFiles )
+{
+    struct PRELOAD_ITEM
+    {
+        wxString      fileName;
+        bool          hasSHA1 = false;
+        unsigned char sha1sum[20];
+        std::string   pluginInfo;
+        SCENEGRAPH*   sceneData = NULL;
+        S3DMODEL*     renderData = NULL;
+        bool          fromModelCache = false;
+        bool          fromSceneCache = false;
+    };
+
+    std::vector<PRELOAD_ITEM> items;
+
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+        std::set<wxString> pending;
+
+        for( const wxString& modelFile : aModelFiles )
+        {
+            wxString full3Dpath = m_FNResolver->ResolvePath( modelFile );
+
+            if( full3Dpath.empty() || m_CacheMap.count( full3Dpath )
+                    || !pending.insert( full3Dpath ).second )
+                continue;
+
+            PRELOAD_ITEM item;
+            item.fileName = full3Dpath;
+            items.push_back( item );
+        }
+    }
+
+    if( items.empty() )
+        return;
+
+    // Load the render data; nothing shared is modified here, the cache entries are
+    // only created afterwards
+    std::atomic<size_t> nextItem( 0 );
+    size_t              parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ), items.size() );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        returns[ii] = std::async( std::launch::async, [&]()
+        {
+            for( size_t i = nextItem.fetch_add( 1 ); i < items.size(); i = nextItem.fetch_add( 1 ) )
+            {
+                PRELOAD_ITEM& item = items[i];
+
+                item.hasSHA1 = !m_CacheDir.empty() && getSHA1( item.fileName, item.sha1sum );
+
+                if( !item.hasSHA1 )
+                    continue;
+
+                wxString cacheName = m_CacheDir + sha1ToWXString( item.sha1sum );
+                wxString modelCacheName = cacheName + wxT( ".3dm" );
+                wxString sceneCacheName = cacheName + wxT( ".3dc" );
+
+                if( wxFileName::FileExists( modelCacheName ) )
+                    item.renderData = S3D::ReadModelCache( modelCacheName.ToUTF8(), m_Plugins,
+                                                           checkTag );
+
+                if( item.renderData )
+                {
+                    item.fromModelCache = true;
+                    continue;
+                }
+
+                if( wxFileName::FileExists( sceneCacheName ) )
+                {
+                    item.sceneData = (SCENEGRAPH*) S3D::ReadCache( sceneCacheName.ToUTF8(),
+                                                                   m_Plugins, checkTag,
+                                                                   &item.pluginInfo );
+                    item.fromSceneCache = item.sceneData != NULL;
+                }
+
+                if( !item.sceneData )
+                    item.sceneData = m_Plugins->Load3DModel( item.fileName, item.pluginInfo );
+
+                if( item.sceneData )
+                    item.renderData = S3D::GetModel( item.sceneData );
+            }
+        } );
+    }
+
+    for( auto& ret : returns )
+        ret.wait();
+
+    // Writing the cache files names the scene graph nodes, which is not thread
+    // safe, so the cache is updated serially
+    std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+    for( PRELOAD_ITEM& item : items )
+    {
+        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+        ep->modTime = wxFileName( item.fileName ).GetModificationTime();
+
+        if( !m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
+                                    ( item.fileName, ep ) ).second )
+        {
+            // the model was loaded by another thread in the meantime
+            delete ep;
+            S3D::DestroyNode( (SGNODE*) item.sceneData );
+
+            if( NULL != item.renderData )
+                S3D::Destroy3DModel( &item.renderData );
+
+            continue;
+        }
+
+        m_CacheList.push_back( ep );
+
+        // as in checkCache(), an entry is also created for the models which could
+        // not be loaded to prevent further attempts at loading them
+        if( !item.hasSHA1 )
+            continue;
+
+        ep->SetSHA1( item.sha1sum );
+        ep->pluginInfo = item.pluginInfo;
+        ep->sceneData = item.sceneData;
+        ep->renderData = item.renderData;
+
+        if( NULL != ep->sceneData && !item.fromSceneCache )
+            saveCacheData( ep );
+
+        if( NULL != ep->renderData && !item.fromModelCache )
+            saveModelCacheData( ep );
+    }
+}
+
+
 S3D_CACHE* PROJECT::Get3DCacheManager( bool aUpdateProjDir )
 {
     std::lock_guard<std::mutex> lock( mutex3D_cacheManager );
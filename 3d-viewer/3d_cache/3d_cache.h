@@ -34,6 +34,7 @@
 #include "kicad_string.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -76,10 +77,13 @@ private:
      *
      * @param[in]   aFileName   file name (full or partial path)
      * @param[out]  aCachePtr   optional return address for cache entry pointer
+     * @param[in]   aRenderDataOnly skip the scene graph if the render data can be
+     *                          loaded from the model cache file
      * @return      SCENEGRAPH object associated with file name
-     * @retval      NULL    on error
+     * @retval      NULL    on error, or when only the render data was loaded
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                            bool aRenderDataOnly = false );
 
     /**
      * Function getSHA1
@@ -98,8 +102,15 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    // load render data from a model cache file
+    bool loadModelCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a model cache file
+    bool saveModelCacheData( S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
-    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                      bool aRenderDataOnly = false );
 
 public:
     S3D_CACHE();
@@ -183,6 +194,17 @@ public:
      * @return is a pointer to the render data or NULL if not available
      */
     S3DMODEL* GetModel( const wxString& aModelFileName );
+
+    /**
+     * Function PreloadModels
+     * loads the render data of the models not yet in the cache using all the
+     * available cores, so the following calls to GetModel() are cache hits.
+     * Hashing and reading of the cache files are done in parallel; the plugins
+     * serialize their own loads and the cache is updated from the calling thread.
+     *
+     * @param aModelFiles is the list of partial or full paths of the models
+     */
+    void PreloadModels( const std::vector<wxString>& aModelFiles );
 };
 
 #endif  // CACHE_3D_H
@@ -232,6 +232,7 @@ void S3D_PLUGIN_MANAGER::loadPlugins( void )
             } while( 0 );
 #endif
             m_Plugins.push_back( pp );
+            m_PluginLocks[pp];
             int nf = pp->GetNFilters();
 
             #ifdef DEBUG
@@ -494,6 +495,8 @@ SCENEGRAPH* S3D_PLUGIN_MANAGER::Load3DModel( const wxString& aFileName, std::str
 
     while( sL != items.second )
     {
+        std::lock_guard<std::mutex> lock( m_PluginLocks.at( sL->second ) );
+
         if( sL->second->CanRender() )
         {
             SCENEGRAPH* sp = sL->second->Load( aFileName.ToUTF8() );
@@ -528,6 +531,7 @@ void S3D_PLUGIN_MANAGER::ClosePlugins( void )
 
     while( sP != eP )
     {
+        std::lock_guard<std::mutex> lock( m_PluginLocks.at( *sP ) );
         (*sP)->Close();
         ++sP;
     }
@@ -559,6 +563,9 @@ bool S3D_PLUGIN_MANAGER::CheckTag( const char* aTag )
     while( pS != pE )
     {
         ptag.clear();
+
+        // the plugin info is fixed when the plugin is opened, so reading it does not need
+        // the plugin lock and does not wait for a model load in progress
         (*pS)->GetPluginInfo( ptag );
 
         // if the plugin name matches then the version
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <list>
+#include <mutex>
 #include <string>
 #include <wx/string.h>
 
@@ -50,6 +51,12 @@ private:
     /// list of file filters
     std::list< wxString > m_FileFilters;
 
+    /// one lock per plugin; plugins are not required to be thread safe so a plugin
+    /// is never entered by more than one thread, while different plugins may load
+    /// models concurrently.  Plugins must therefore not change process wide state
+    /// such as the numeric locale while loading.
+    std::map< KICAD_PLUGIN_LDR_3D*, std::mutex > m_PluginLocks;
+
     /// load plugins
     void loadPlugins( void );
 
@@ -82,6 +89,15 @@ public:
      */
     std::list< wxString > const* GetFileFilters( void ) const noexcept;
 
+    /**
+     * Function Load3DModel
+     * loads a model with the first plugin able to render it. This may be called
+     * from several threads; calls into the same plugin are serialized.
+     *
+     * @param aFileName is the full path to the model file
+     * @param aPluginInfo [out] receives the information string of the plugin
+     * @return the scene graph of the model or NULL on failure
+     */
     SCENEGRAPH* Load3DModel( const wxString& aFileName, std::string& aPluginInfo );
 
     /**
@@ -21,9 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <wx/filename.h>
 #include <wx/log.h>
 #include "plugins/3dapi/ifsg_api.h"
@@ -43,6 +46,44 @@ static char BadNode[] = " * [BUG] NULL pointer passed for aNode\n";
 // version format of the cache file
 #define SG_VERSION_TAG "VERSION:2"
 
+// identifier and version of the render data cache file
+#define SG_MODEL_CACHE_TAG "KICAD3DM"
+#define SG_MODEL_CACHE_VERSION 2
+
+// flags of the optional per vertex arrays of a mesh in the render data cache file
+#define SG_MODEL_CACHE_TEXCOORDS 0x01
+#define SG_MODEL_CACHE_COLORS    0x02
+
+
+/**
+ * Header of the render data cache file. The data is written in the native byte order
+ * and layout; the cache is private to the machine that created it and a file written
+ * with a different byte order is simply rejected.
+ *
+ * The header is followed by the tag of the plugin which loaded the model (checked
+ * as the one of the SGNODE cache file), the material array and, for each mesh, by a
+ * MODEL_CACHE_MESH record and the arrays of the mesh (positions, normals, optional
+ * texture coordinates and colors, and face indices).
+ */
+struct MODEL_CACHE_HEADER
+{
+    char     tag[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t pluginInfoSize;
+    uint32_t materialsSize;
+    uint32_t meshesSize;
+};
+
+
+struct MODEL_CACHE_MESH
+{
+    uint32_t vertexSize;
+    uint32_t faceIdxSize;
+    uint32_t materialIdx;
+    uint32_t flags;
+};
+
 
 static void formatMaterial( SMATERIAL& mat, SGAPPEARANCE const* app )
 {
@@ -319,7 +360,7 @@ bool S3D::WriteCache( const char* aFileName, bool overwrite, SGNODE* aNode,
 
 
 SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
-        bool (*aTagCheck)( const char*, void* ) )
+        bool (*aTagCheck)( const char*, void* ), std::string* aPluginInfo )
 {
     if( NULL == aFileName || aFileName[0] == 0 )
         return NULL;
@@ -447,6 +488,9 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
             return NULL;
         }
 
+        if( NULL != aPluginInfo )
+            *aPluginInfo = name;
+
     } while( 0 );
 
     bool rval = np->ReadCache( file, NULL );
@@ -468,6 +512,264 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
 }
 
 
+bool S3D::WriteModelCache( const char* aFileName, const S3DMODEL* aModel,
+        const char* aPluginInfo )
+{
+    if( NULL == aFileName || aFileName[0] == 0 || NULL == aModel )
+        return false;
+
+    // without the plugin tag, the file could never be read back
+    if( NULL == aPluginInfo || aPluginInfo[0] == 0 )
+        return false;
+
+    wxString ofile = wxString::FromUTF8Unchecked( aFileName );
+
+    // make sure we make no attempt to write a directory
+    if( wxFileName::Exists( ofile ) && !wxFileName::FileExists( ofile ) )
+    {
+        wxString errmsg;
+        errmsg << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+        errmsg << " * [INFO] " << "specified path is a directory" << " '";
+        errmsg << aFileName << "'";
+        wxLogTrace( MASK_3D_SG, errmsg );
+        return false;
+    }
+
+    OPEN_OSTREAM( output, aFileName );
+
+    if( output.fail() )
+    {
+        wxString errmsg;
+        errmsg << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+        errmsg << " * [INFO] " << "failed to open file" << " '" << aFileName << "'";
+        wxLogTrace( MASK_3D_SG, errmsg );
+        return false;
+    }
+
+    MODEL_CACHE_HEADER header;
+    memcpy( header.tag, SG_MODEL_CACHE_TAG, sizeof( header.tag ) );
+    header.version       = SG_MODEL_CACHE_VERSION;
+    header.byteOrder      = 0x01020304;
+    header.pluginInfoSize = (uint32_t) strlen( aPluginInfo );
+    header.materialsSize  = aModel->m_MaterialsSize;
+    header.meshesSize     = aModel->m_MeshesSize;
+
+    output.write( (const char*) &header, sizeof( header ) );
+    output.write( aPluginInfo, header.pluginInfoSize );
+    output.write( (const char*) aModel->m_Materials,
+                  sizeof( SMATERIAL ) * aModel->m_MaterialsSize );
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize && !output.fail(); ++i )
+    {
+        const SMESH& mesh = aModel->m_Meshes[i];
+
+        MODEL_CACHE_MESH meshHeader;
+        meshHeader.vertexSize  = mesh.m_VertexSize;
+        meshHeader.faceIdxSize = mesh.m_FaceIdxSize;
+        meshHeader.materialIdx = mesh.m_MaterialIdx;
+        meshHeader.flags       = 0;
+
+        if( NULL != mesh.m_Texcoords )
+            meshHeader.flags |= SG_MODEL_CACHE_TEXCOORDS;
+
+        if( NULL != mesh.m_Color )
+            meshHeader.flags |= SG_MODEL_CACHE_COLORS;
+
+        output.write( (const char*) &meshHeader, sizeof( meshHeader ) );
+        output.write( (const char*) mesh.m_Positions, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+        output.write( (const char*) mesh.m_Normals, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+
+        if( NULL != mesh.m_Texcoords )
+            output.write( (const char*) mesh.m_Texcoords, sizeof( SFVEC2F ) * mesh.m_VertexSize );
+
+        if( NULL != mesh.m_Color )
+            output.write( (const char*) mesh.m_Color, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+
+        output.write( (const char*) mesh.m_FaceIdx, sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    bool rval = !output.fail();
+    CLOSE_STREAM( output );
+
+    if( !rval )
+    {
+        wxString errmsg;
+        errmsg << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+        errmsg << " * [INFO] " << "problems encountered writing model cache file" << " '";
+        errmsg << aFileName << "'";
+        wxLogTrace( MASK_3D_SG, errmsg );
+
+        // delete the defective file
+        wxRemoveFile( ofile );
+    }
+
+    return rval;
+}
+
+
+/**
+ * Copy aCount elements of type T from the cache data at aOffset to a new array,
+ * advancing aOffset.
+ *
+ * @return the new array or NULL if the data is too short
+ */
+template <typename T>
+static T* readModelCacheArray( const std::vector<char>& aData, size_t& aOffset, size_t aCount )
+{
+    if( aCount > ( aData.size() - aOffset ) / sizeof( T ) )
+        return NULL;
+
+    T* array = new T[aCount];
+    memcpy( (void*) array, aData.data() + aOffset, sizeof( T ) * aCount );
+    aOffset += sizeof( T ) * aCount;
+
+    return array;
+}
+
+
+S3DMODEL* S3D::ReadModelCache( const char* aFileName, void* aPluginMgr,
+        bool (*aTagCheck)( const char*, void* ) )
+{
+    if( NULL == aFileName || aFileName[0] == 0 )
+        return NULL;
+
+    if( !wxFileName::FileExists( wxString::FromUTF8Unchecked( aFileName ) ) )
+        return NULL;
+
+    OPEN_ISTREAM( file, aFileName );
+
+    if( file.fail() )
+    {
+        CLOSE_STREAM( file );
+        return NULL;
+    }
+
+    // read the whole file at once; all the arrays are then copied out of this
+    // buffer without any further parsing
+    file.seekg( 0, std::ios_base::end );
+    std::streamoff fileSize = file.tellg();
+    file.seekg( 0, std::ios_base::beg );
+
+    if( fileSize < (std::streamoff) sizeof( MODEL_CACHE_HEADER ) )
+    {
+        CLOSE_STREAM( file );
+        return NULL;
+    }
+
+    std::vector<char> data( (size_t) fileSize );
+    file.read( data.data(), fileSize );
+    bool readOk = !file.fail();
+    CLOSE_STREAM( file );
+
+    if( !readOk )
+        return NULL;
+
+    MODEL_CACHE_HEADER header;
+    memcpy( &header, data.data(), sizeof( header ) );
+
+    if( memcmp( header.tag, SG_MODEL_CACHE_TAG, sizeof( header.tag ) )
+            || header.version != SG_MODEL_CACHE_VERSION
+            || header.byteOrder != 0x01020304
+            || header.materialsSize == 0 || header.meshesSize == 0
+            || header.pluginInfoSize > data.size() - sizeof( header ) )
+    {
+        return NULL;
+    }
+
+    size_t offset = sizeof( header );
+
+    // check the plugin tag, so that the render data of an upgraded or reconfigured
+    // plugin is not used
+    std::string pluginInfo( data.data() + offset, header.pluginInfoSize );
+    offset += header.pluginInfoSize;
+
+    if( NULL != aTagCheck && NULL != aPluginMgr && !aTagCheck( pluginInfo.c_str(), aPluginMgr ) )
+        return NULL;
+
+    S3DMODEL* model = S3D::New3DModel();
+
+    model->m_Materials = readModelCacheArray<SMATERIAL>( data, offset, header.materialsSize );
+
+    if( NULL == model->m_Materials )
+    {
+        S3D::Destroy3DModel( &model );
+        return NULL;
+    }
+
+    model->m_MaterialsSize = header.materialsSize;
+    model->m_Meshes = new SMESH[header.meshesSize];
+    model->m_MeshesSize = header.meshesSize;
+
+    for( unsigned int i = 0; i < header.meshesSize; ++i )
+        S3D::INIT_SMESH( model->m_Meshes[i] );
+
+    for( unsigned int i = 0; i < header.meshesSize; ++i )
+    {
+        SMESH&           mesh = model->m_Meshes[i];
+        MODEL_CACHE_MESH meshHeader;
+
+        if( data.size() - offset < sizeof( meshHeader ) )
+        {
+            S3D::Destroy3DModel( &model );
+            return NULL;
+        }
+
+        memcpy( &meshHeader, data.data() + offset, sizeof( meshHeader ) );
+        offset += sizeof( meshHeader );
+
+        if( meshHeader.materialIdx >= header.materialsSize )
+        {
+            S3D::Destroy3DModel( &model );
+            return NULL;
+        }
+
+        mesh.m_VertexSize  = meshHeader.vertexSize;
+        mesh.m_FaceIdxSize = meshHeader.faceIdxSize;
+        mesh.m_MaterialIdx = meshHeader.materialIdx;
+
+        mesh.m_Positions = readModelCacheArray<SFVEC3F>( data, offset, meshHeader.vertexSize );
+        bool ok = NULL != mesh.m_Positions;
+
+        if( ok )
+        {
+            mesh.m_Normals = readModelCacheArray<SFVEC3F>( data, offset, meshHeader.vertexSize );
+            ok = NULL != mesh.m_Normals;
+        }
+
+        if( ok && ( meshHeader.flags & SG_MODEL_CACHE_TEXCOORDS ) )
+        {
+            mesh.m_Texcoords = readModelCacheArray<SFVEC2F>( data, offset,
+                                                             meshHeader.vertexSize );
+            ok = NULL != mesh.m_Texcoords;
+        }
+
+        if( ok && ( meshHeader.flags & SG_MODEL_CACHE_COLORS ) )
+        {
+            mesh.m_Color = readModelCacheArray<SFVEC3F>( data, offset, meshHeader.vertexSize );
+            ok = NULL != mesh.m_Color;
+        }
+
+        if( ok )
+        {
+            mesh.m_FaceIdx = readModelCacheArray<unsigned int>( data, offset,
+                                                                meshHeader.faceIdxSize );
+            ok = NULL != mesh.m_FaceIdx;
+        }
+
+        if( !ok )
+        {
+            wxLogTrace( MASK_3D_SG, "%s:%s:%d\n * [INFO] corrupt model cache file '%s'",
+                        __FILE__, __FUNCTION__, __LINE__, aFileName );
+
+            S3D::Destroy3DModel( &model );
+            return NULL;
+        }
+    }
+
+    return model;
+}
+
+
 S3DMODEL* S3D::GetModel( SCENEGRAPH* aNode )
 {
     if( NULL == aNode )
@@ -55,9 +55,39 @@
 #include <thread>
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <future>
 
 #include <profile.h>
 
+
+/**
+ * Calls aFunction once for every index in [0, aCount), spreading the calls over worker
+ * threads that each pick up the next index still to be processed.
+ */
+static void parallelForEach( size_t aCount, const std::function<void( size_t )>& aFunction )
+{
+    std::atomic<size_t> nextItem( 0 );
+
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+            aCount );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        returns[ii] = std::async( std::launch::async, [&nextItem, aCount, &aFunction]()
+        {
+            for( size_t i = nextItem.fetch_add( 1 ); i < aCount; i = nextItem.fetch_add( 1 ) )
+                aFunction( i );
+        } );
+    }
+
+    for( auto& ret : returns )
+        ret.wait();
+}
+
+
 void BOARD_ADAPTER::destroyLayers()
 {
     if( !m_layers_poly.empty() )
@@ -690,39 +720,18 @@ void BOARD_ADAPTER::createLayers( REPORTER *aStatusTextReporter )
 
         // Add zones objects
         // /////////////////////////////////////////////////////////////////////
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        parallelForEach( m_board->GetAreaCount(), [this]( size_t areaId )
         {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < static_cast<size_t>( m_board->GetAreaCount() );
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
-
-                    if( zone == nullptr )
-                        break;
-
-                    auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
+            const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
 
-                    if( layerContainer != m_layers_container2D.end() )
-                        AddSolidAreasShapesToContainer( zone, layerContainer->second,
-                                                        zone->GetLayer() );
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
+            if( zone == nullptr )
+                return;
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
 
+            if( layerContainer != m_layers_container2D.end() )
+                AddSolidAreasShapesToContainer( zone, layerContainer->second, zone->GetLayer() );
+        } );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -760,35 +769,14 @@ void BOARD_ADAPTER::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
             && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
     {
-        std::atomic<size_t> nextItem( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>(
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                layer_id.size() );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        parallelForEach( layer_id.size(), [&layer_id, this]( size_t i )
         {
-            std::thread t = std::thread( [&nextItem, &threadsFinished, &layer_id, this]()
-            {
-                for( size_t i = nextItem.fetch_add( 1 );
-                            i < layer_id.size();
-                            i = nextItem.fetch_add( 1 ) )
-                {
-                    auto layerPoly = m_layers_poly.find( layer_id[i] );
-
-                    if( layerPoly != m_layers_poly.end() )
-                        // This will make a union of all added contours
-                        layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
-                }
-
-                threadsFinished++;
-            } );
+            auto layerPoly = m_layers_poly.find( layer_id[i] );
 
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            if( layerPoly != m_layers_poly.end() )
+                // This will make a union of all added contours
+                layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
+        } );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -801,34 +789,39 @@ void BOARD_ADAPTER::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Simplify holes contours" ) );
 
+    // Each layer owns its hole polygons, so they can be simplified concurrently
+    std::vector<SHAPE_POLY_SET*> holesPolys;
+
     for( PCB_LAYER_ID layer : layer_id )
     {
         if( m_layers_outer_holes_poly.find( layer ) != m_layers_outer_holes_poly.end() )
         {
             // found
-            SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            holesPolys.push_back( m_layers_outer_holes_poly[layer] );
 
             wxASSERT( m_layers_inner_holes_poly.find( layer ) != m_layers_inner_holes_poly.end() );
 
-            polyLayer = m_layers_inner_holes_poly[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            holesPolys.push_back( m_layers_inner_holes_poly[layer] );
         }
     }
 
+    // This will make a union of all added contourns
+    holesPolys.push_back( &m_through_inner_holes_poly );
+    holesPolys.push_back( &m_through_outer_holes_poly );
+    holesPolys.push_back( &m_through_outer_holes_poly_NPTH );
+    holesPolys.push_back( &m_through_outer_holes_vias_poly );
+    //holesPolys.push_back( &m_through_inner_holes_vias_poly ); // Not in use
+
+    parallelForEach( holesPolys.size(), [&holesPolys]( size_t i )
+    {
+        holesPolys[i]->Simplify( SHAPE_POLY_SET::PM_FAST );
+    } );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
 #endif
     // End Build Copper layers
 
-
-    // This will make a union of all added contourns
-    m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
-
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
 #endif
@@ -1039,22 +1032,27 @@ void BOARD_ADAPTER::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_through_holes_inner.BuildBVH();
-    m_through_holes_outer.BuildBVH();
+    // The containers are independent, so their BVHs are built concurrently
+    std::vector<CBVHCONTAINER2D*> bvhContainers;
 
-    if( !m_layers_holes2D.empty() )
-    {
-        for( auto& hole : m_layers_holes2D)
-            hole.second->BuildBVH();
-    }
+    bvhContainers.push_back( &m_through_holes_inner );
+    bvhContainers.push_back( &m_through_holes_outer );
+
+    for( auto& hole : m_layers_holes2D )
+        bvhContainers.push_back( hole.second );
 
     // We only need the Solder mask to initialize the BVH
     // because..?
     if( m_layers_container2D[B_Mask] )
-        m_layers_container2D[B_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layers_container2D[B_Mask] );
 
     if( m_layers_container2D[F_Mask] )
-        m_layers_container2D[F_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layers_container2D[F_Mask] );
+
+    parallelForEach( bvhContainers.size(), [&bvhContainers]( size_t i )
+    {
+        bvhContainers[i]->BuildBVH();
+    } );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
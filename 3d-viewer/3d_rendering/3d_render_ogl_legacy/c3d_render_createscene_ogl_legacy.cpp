@@ -901,6 +901,21 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER *aStatusTextReporter )
        (!m_boardAdapter.GetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL )) )
         return;
 
+    // Load all the models not yet in memory at once, so they are read in parallel
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_boardAdapter.GetBoard()->Modules() )
+    {
+        for( const MODULE_3D_SETTINGS& model : module->Models() )
+        {
+            if( model.m_Show && !model.m_Filename.empty()
+                    && m_3dmodel_map.find( model.m_Filename ) == m_3dmodel_map.end() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    m_boardAdapter.Get3DCacheManager()->PreloadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_boardAdapter.GetBoard()->Modules() )
     {
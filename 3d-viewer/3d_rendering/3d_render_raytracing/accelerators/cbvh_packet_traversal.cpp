@@ -148,6 +148,7 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                                 anyHitted |= hitted;
                                 aHitInfoPacket[i].m_hitresult |= hitted;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                aHitInfoPacket[i].m_HitInfo.pAccObject = obj;
                             }
                         }
                     }
@@ -274,6 +275,7 @@ bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                                 anyHitted |= hitted;
                                 aHitInfoPacket[idx].m_hitresult |= hitted;
                                 aHitInfoPacket[idx].m_HitInfo.m_acc_node_info = nodeNum;
+                                aHitInfoPacket[idx].m_HitInfo.pAccObject = obj;
                             }
                         }
                     }
@@ -619,41 +619,43 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
                         buckets[b].bounds.Union( primitiveInfo[i].bounds );
                     }
 
-                    // Compute costs for splitting after each bucket
+                    // Compute costs for splitting after each bucket.
+                    // The buckets are swept once from each side, accumulating the
+                    // bounds, instead of merging them again for every split position
                     float cost[nBuckets - 1];
+                    float leftCost[nBuckets - 1];
+
+                    CBBOX b0;
+                    b0.Reset();
+                    int count0 = 0;
 
                     for( int i = 0; i < (nBuckets - 1); ++i )
                     {
-                        CBBOX b0, b1;
-
-                        b0.Reset();
-                        b1.Reset();
-
-                        int count0 = 0;
-                        int count1 = 0;
-
-                        for( int j = 0; j <= i; ++j )
+                        if( buckets[i].count )
                         {
-                            if( buckets[j].count )
-                            {
-                                count0 += buckets[j].count;
-                                b0.Union( buckets[j].bounds );
-                            }
+                            count0 += buckets[i].count;
+                            b0.Union( buckets[i].bounds );
                         }
 
-                        for( int j = i + 1; j < nBuckets; ++j )
+                        leftCost[i] = count0 * b0.SurfaceArea();
+                    }
+
+                    CBBOX b1;
+                    b1.Reset();
+                    int count1 = 0;
+
+                    for( int i = nBuckets - 1; i > 0; --i )
+                    {
+                        if( buckets[i].count )
                         {
-                            if( buckets[j].count )
-                            {
-                                count1 += buckets[j].count;
-                                b1.Union( buckets[j].bounds );
-                            }
+                            count1 += buckets[i].count;
+                            b1.Union( buckets[i].bounds );
                         }
 
-                        cost[i] = 1.0f +
-                                  ( count0 * b0.SurfaceArea() +
-                                    count1 * b1.SurfaceArea() ) /
-                                  bounds.SurfaceArea();
+                        cost[i - 1] = 1.0f +
+                                      ( leftCost[i - 1] +
+                                        count1 * b1.SurfaceArea() ) /
+                                      bounds.SurfaceArea();
                     }
 
                     // Find bucket to split at that minimizes SAH metric
@@ -1166,10 +1168,12 @@ bool CBVH_PBRT::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
                 // Intersect ray with primitives in leaf BVH node
                 for( int i = 0; i < node->nPrimitives; ++i )
                 {
-                    if( m_primitives[node->primitivesOffset + i]->Intersect( aRay,
-                                                                             aHitInfo ) )
+                    const COBJECT *obj = m_primitives[node->primitivesOffset + i];
+
+                    if( obj->Intersect( aRay, aHitInfo ) )
                     {
                         aHitInfo.m_acc_node_info = nodeNum;
+                        aHitInfo.pAccObject = obj;
                         hit = true;
                     }
                 }
@@ -1233,10 +1237,12 @@ bool CBVH_PBRT::Intersect( const RAY &aRay,
                 // Intersect ray with primitives in leaf BVH node
                 for( int i = 0; i < node->nPrimitives; ++i )
                 {
-                    if( m_primitives[node->primitivesOffset + i]->Intersect( aRay,
-                                                                             aHitInfo ) )
+                    const COBJECT *obj = m_primitives[node->primitivesOffset + i];
+
+                    if( obj->Intersect( aRay, aHitInfo ) )
                     {
                         //aHitInfo.m_acc_node_info = nodeNum;
+                        aHitInfo.pAccObject = obj;
                         hit = true;
                     }
                 }
@@ -28,6 +28,7 @@
  */
 
 #include "ccontainer2d.h"
+#include <algorithm>
 #include <vector>
 #include <mutex>
 #include <boost/range/algorithm/partition.hpp>
@@ -300,21 +301,6 @@ void CBVHCONTAINER2D::BuildBVH()
 // "Creates a binary tree with Top-Down approach.
 //  Fastest BVH building, but least [speed] accuracy."
 
-static bool sortByCentroid_X( const COBJECT2D *a, const COBJECT2D *b )
-{
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
-
-static bool sortByCentroid_Y( const COBJECT2D *a, const COBJECT2D *b )
-{
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
-
-static bool sortByCentroid_Z( const COBJECT2D *a, const COBJECT2D *b )
-{
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
-
 void CBVHCONTAINER2D::recursiveBuild_MIDDLE_SPLIT( BVH_CONTAINER_NODE_2D *aNodeParent )
 {
     wxASSERT( aNodeParent != NULL );
@@ -337,23 +323,25 @@ void CBVHCONTAINER2D::recursiveBuild_MIDDLE_SPLIT( BVH_CONTAINER_NODE_2D *aNodeP
         // Decide wich axis to split
         const unsigned int axis_to_split = aNodeParent->m_BBox.MaxDimension();
 
-        // Divide the objects
-        switch( axis_to_split )
-        {
-            case 0: aNodeParent->m_LeafList.sort( sortByCentroid_X ); break;
-            case 1: aNodeParent->m_LeafList.sort( sortByCentroid_Y ); break;
-            case 2: aNodeParent->m_LeafList.sort( sortByCentroid_Z ); break;
-        }
+        // Divide the objects around the median centroid. Only the median has to be found,
+        // so a selection is enough (no need to sort the whole list on each level)
+        std::vector<const COBJECT2D *> objects( aNodeParent->m_LeafList.begin(),
+                                                aNodeParent->m_LeafList.end() );
+
+        const size_t middle = objects.size() / 2;
 
-        unsigned int i = 0;
+        std::nth_element( objects.begin(), objects.begin() + middle, objects.end(),
+                          [axis_to_split]( const COBJECT2D *a, const COBJECT2D *b )
+                          {
+                              return a->GetCentroid()[axis_to_split] <
+                                     b->GetCentroid()[axis_to_split];
+                          } );
 
-        for( CONST_LIST_OBJECT2D::const_iterator ii = aNodeParent->m_LeafList.begin();
-             ii != aNodeParent->m_LeafList.end();
-             ++ii )
+        for( size_t i = 0; i < objects.size(); ++i )
         {
-            const COBJECT2D *object = static_cast<const COBJECT2D *>(*ii);
+            const COBJECT2D *object = objects[i];
 
-            if( i < (aNodeParent->m_LeafList.size() / 2 ) )
+            if( i < middle )
             {
                 leftNode->m_BBox.Union( object->GetBBox() );
                 leftNode->m_LeafList.push_back( object );
@@ -363,8 +351,6 @@ void CBVHCONTAINER2D::recursiveBuild_MIDDLE_SPLIT( BVH_CONTAINER_NODE_2D *aNodeP
                 rightNode->m_BBox.Union( object->GetBBox() );
                 rightNode->m_LeafList.push_back( object );
             }
-
-            i++;
         }
 
         wxASSERT( leftNode->m_LeafList.size() > 0 );
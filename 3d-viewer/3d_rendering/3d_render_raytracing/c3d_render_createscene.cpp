@@ -34,6 +34,7 @@
 #include "shapes3D/clayeritem.h"
 #include "shapes3D/ccylinder.h"
 #include "shapes3D/ctriangle.h"
+#include "shapes3D/cinstance.h"
 #include "shapes2D/citemlayercsg2d.h"
 #include "shapes2D/cring2d.h"
 #include "shapes2D/cpolygon2d.h"
@@ -284,6 +285,7 @@ void C3D_RENDER_RAYTRACING::reload( REPORTER* aStatusTextReporter, REPORTER* aWa
 
     m_object_container.Clear();
     m_containerWithObjectsToDelete.Clear();
+    m_model_geometry.clear();
 
 
     // Create and add the outline board
@@ -1284,6 +1286,28 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    // Offscreen renders can be done without a model cache, the board is drawn without models
+    if( !m_boardAdapter.Get3DCacheManager() )
+        return;
+
+    // Load all the models to be displayed at once, so they are read in parallel
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_boardAdapter.GetBoard()->Modules() )
+    {
+        if( !m_boardAdapter.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+            continue;
+
+        for( const MODULE_3D_SETTINGS& model : module->Models() )
+        {
+            if( ( static_cast<float>( model.m_Opacity ) > FLT_EPSILON ) &&
+                ( model.m_Show && !model.m_Filename.empty() ) )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    m_boardAdapter.Get3DCacheManager()->PreloadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_boardAdapter.GetBoard()->Modules() )
     {
@@ -1532,97 +1556,139 @@ void C3D_RENDER_RAYTRACING::add_3D_models( const S3DMODEL *a3DModel,
             }
         }
 
-        const glm::mat3 normalMatrix = glm::transpose( glm::inverse( glm::mat3( aModelMatrix ) ) );
+        // The triangles of a model are created only once, in model coordinates scaled to
+        // 3D units, and each footprint adds an instance of them placed by its own matrix.
+        // A mirrored placement reverses the triangle winding, so it needs its own triangles
+        // to keep the back face test working.
+        const float modelunit_to_3d_units_factor = m_boardAdapter.BiuTo3Dunits() *
+                                                   UNITS3D_TO_UNITSPCB;
+
+        const bool isMirrored = glm::determinant( glm::mat3( aModelMatrix ) ) < 0.0f;
+
+        MODEL_GEOMETRY &geometry =
+                m_model_geometry[MODEL_GEOMETRY_KEY( a3DModel, aModuleOpacity, isMirrored )];
+
+        if( geometry.m_accelerator == NULL )
+        {
+            add_3D_model_triangles( geometry.m_triangles, a3DModel, *materialVector,
+                                    modelunit_to_3d_units_factor, aModuleOpacity, isMirrored );
+
+            geometry.m_accelerator = new CBVH_PBRT( geometry.m_triangles );
+        }
+
+        if( geometry.m_triangles.GetList().empty() )
+            return;
+
+        const glm::mat4 localToWorld = glm::scale( aModelMatrix,
+                                                   SFVEC3F( 1.0f / modelunit_to_3d_units_factor ) );
+
+        m_object_container.Add( new CINSTANCE( geometry.m_accelerator,
+                                               geometry.m_triangles.GetBBox(),
+                                               localToWorld ) );
+    }
+}
+
 
-        for( unsigned int mesh_i = 0;
-             mesh_i < a3DModel->m_MeshesSize;
-             ++mesh_i )
+void C3D_RENDER_RAYTRACING::add_3D_model_triangles( CCONTAINER &aDstContainer,
+                                                    const S3DMODEL *a3DModel,
+                                                    const MODEL_MATERIALS &aMaterials,
+                                                    float aScale,
+                                                    float aModuleOpacity,
+                                                    bool aIsMirrored )
+{
+    for( unsigned int mesh_i = 0;
+         mesh_i < a3DModel->m_MeshesSize;
+         ++mesh_i )
+    {
+        const SMESH &mesh = a3DModel->m_Meshes[mesh_i];
+
+        // Validate the mesh pointers
+        wxASSERT( mesh.m_Positions != NULL );
+        wxASSERT( mesh.m_FaceIdx != NULL );
+        wxASSERT( mesh.m_Normals != NULL );
+        wxASSERT( mesh.m_FaceIdxSize > 0 );
+        wxASSERT( (mesh.m_FaceIdxSize % 3) == 0 );
+
+
+        if( (mesh.m_Positions != NULL) &&
+            (mesh.m_Normals != NULL) &&
+            (mesh.m_FaceIdx != NULL) &&
+            (mesh.m_FaceIdxSize > 0) &&
+            (mesh.m_VertexSize > 0) &&
+            ((mesh.m_FaceIdxSize % 3) == 0) &&
+            (mesh.m_MaterialIdx < a3DModel->m_MaterialsSize) )
         {
-            const SMESH &mesh = a3DModel->m_Meshes[mesh_i];
-
-            // Validate the mesh pointers
-            wxASSERT( mesh.m_Positions != NULL );
-            wxASSERT( mesh.m_FaceIdx != NULL );
-            wxASSERT( mesh.m_Normals != NULL );
-            wxASSERT( mesh.m_FaceIdxSize > 0 );
-            wxASSERT( (mesh.m_FaceIdxSize % 3) == 0 );
-
-
-            if( (mesh.m_Positions != NULL) &&
-                (mesh.m_Normals != NULL) &&
-                (mesh.m_FaceIdx != NULL) &&
-                (mesh.m_FaceIdxSize > 0) &&
-                (mesh.m_VertexSize > 0) &&
-                ((mesh.m_FaceIdxSize % 3) == 0) &&
-                (mesh.m_MaterialIdx < a3DModel->m_MaterialsSize) )
+            const CBLINN_PHONG_MATERIAL &blinn_material = aMaterials[mesh.m_MaterialIdx];
+
+            // Add all face triangles
+            for( unsigned int faceIdx = 0;
+                 faceIdx < mesh.m_FaceIdxSize;
+                 faceIdx += 3 )
             {
-                const CBLINN_PHONG_MATERIAL &blinn_material = (*materialVector)[mesh.m_MaterialIdx];
+                const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
+                const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
+                const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
 
-                // Add all face triangles
-                for( unsigned int faceIdx = 0;
-                     faceIdx < mesh.m_FaceIdxSize;
-                     faceIdx += 3 )
-                {
-                    const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
-                    const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
-                    const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
+                wxASSERT( idx0 < mesh.m_VertexSize );
+                wxASSERT( idx1 < mesh.m_VertexSize );
+                wxASSERT( idx2 < mesh.m_VertexSize );
 
-                    wxASSERT( idx0 < mesh.m_VertexSize );
-                    wxASSERT( idx1 < mesh.m_VertexSize );
-                    wxASSERT( idx2 < mesh.m_VertexSize );
+                if( ( idx0 < mesh.m_VertexSize ) &&
+                    ( idx1 < mesh.m_VertexSize ) &&
+                    ( idx2 < mesh.m_VertexSize ) )
+                {
+                    const SFVEC3F &v0 = mesh.m_Positions[idx0];
+                    const SFVEC3F &v1 = mesh.m_Positions[idx1];
+                    const SFVEC3F &v2 = mesh.m_Positions[idx2];
 
-                    if( ( idx0 < mesh.m_VertexSize ) &&
-                        ( idx1 < mesh.m_VertexSize ) &&
-                        ( idx2 < mesh.m_VertexSize ) )
-                    {
-                        const SFVEC3F &v0 = mesh.m_Positions[idx0];
-                        const SFVEC3F &v1 = mesh.m_Positions[idx1];
-                        const SFVEC3F &v2 = mesh.m_Positions[idx2];
+                    const SFVEC3F &n0 = mesh.m_Normals[idx0];
+                    const SFVEC3F &n1 = mesh.m_Normals[idx1];
+                    const SFVEC3F &n2 = mesh.m_Normals[idx2];
 
-                        const SFVEC3F &n0 = mesh.m_Normals[idx0];
-                        const SFVEC3F &n1 = mesh.m_Normals[idx1];
-                        const SFVEC3F &n2 = mesh.m_Normals[idx2];
+                    // Scale vertex to 3D units, the normals are kept as the
+                    // scale is uniform
+                    const SFVEC3F vt0 = v0 * aScale;
+                    const SFVEC3F vt1 = v1 * aScale;
+                    const SFVEC3F vt2 = v2 * aScale;
 
-                        // Transform vertex with the model matrix
-                        const SFVEC3F vt0 = SFVEC3F( aModelMatrix * glm::vec4( v0, 1.0f) );
-                        const SFVEC3F vt1 = SFVEC3F( aModelMatrix * glm::vec4( v1, 1.0f) );
-                        const SFVEC3F vt2 = SFVEC3F( aModelMatrix * glm::vec4( v2, 1.0f) );
+                    const SFVEC3F nt0 = glm::normalize( n0 );
+                    const SFVEC3F nt1 = glm::normalize( n1 );
+                    const SFVEC3F nt2 = glm::normalize( n2 );
 
-                        const SFVEC3F nt0 = glm::normalize( SFVEC3F( normalMatrix * n0 ) );
-                        const SFVEC3F nt1 = glm::normalize( SFVEC3F( normalMatrix * n1 ) );
-                        const SFVEC3F nt2 = glm::normalize( SFVEC3F( normalMatrix * n2 ) );
+                    CTRIANGLE *newTriangle;
 
-                        CTRIANGLE *newTriangle = new  CTRIANGLE( vt0, vt2, vt1,
-                                                                 nt0, nt2, nt1 );
+                    if( aIsMirrored )
+                        newTriangle = new CTRIANGLE( vt0, vt1, vt2, nt0, nt1, nt2 );
+                    else
+                        newTriangle = new CTRIANGLE( vt0, vt2, vt1, nt0, nt2, nt1 );
 
-                        m_object_container.Add( newTriangle );
-                        newTriangle->SetMaterial( (const CMATERIAL *)&blinn_material );
+                    aDstContainer.Add( newTriangle );
+                    newTriangle->SetMaterial( (const CMATERIAL *)&blinn_material );
 
-                        const float moduleTransparency = 1.0f - ( ( 1.0f - blinn_material.GetTransparency() ) * aModuleOpacity );
+                    const float moduleTransparency = 1.0f - ( ( 1.0f - blinn_material.GetTransparency() ) * aModuleOpacity );
 
-                        newTriangle->SetModelTransparency( moduleTransparency );
+                    newTriangle->SetModelTransparency( moduleTransparency );
 
-                        if( mesh.m_Color == NULL )
-                        {
-                            const SFVEC3F diffuseColor =
-                                a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse;
+                    if( mesh.m_Color == NULL )
+                    {
+                        const SFVEC3F diffuseColor =
+                            a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse;
 
-                            if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
-                                newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( diffuseColor ) ) );
-                            else
-                                newTriangle->SetColor( ConvertSRGBToLinear( diffuseColor ) );
-                        }
+                        if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
+                            newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( diffuseColor ) ) );
                         else
-                        {
-                            if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
-                                newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx0] ) ),
-                                                       ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx1] ) ),
-                                                       ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx2] ) ) );
-                            else
-                                newTriangle->SetColor( ConvertSRGBToLinear( mesh.m_Color[idx0] ),
-                                                       ConvertSRGBToLinear( mesh.m_Color[idx1] ),
-                                                       ConvertSRGBToLinear( mesh.m_Color[idx2] ) );
-                        }
+                            newTriangle->SetColor( ConvertSRGBToLinear( diffuseColor ) );
+                    }
+                    else
+                    {
+                        if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
+                            newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx0] ) ),
+                                                   ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx1] ) ),
+                                                   ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx2] ) ) );
+                        else
+                            newTriangle->SetColor( ConvertSRGBToLinear( mesh.m_Color[idx0] ),
+                                                   ConvertSRGBToLinear( mesh.m_Color[idx1] ),
+                                                   ConvertSRGBToLinear( mesh.m_Color[idx2] ) );
                     }
                 }
             }
@@ -48,7 +48,8 @@
 
 C3D_RENDER_RAYTRACING::C3D_RENDER_RAYTRACING( BOARD_ADAPTER& aAdapter, CCAMERA& aCamera ) :
                        C3D_RENDER_BASE( aAdapter, aCamera ),
-                       m_postshader_ssao( aCamera )
+                       m_postshader_ssao( aCamera ),
+                       m_workers( std::max<size_t>( std::thread::hardware_concurrency(), 2 ) )
 {
     wxLogTrace( m_logTrace, wxT( "C3D_RENDER_RAYTRACING::C3D_RENDER_RAYTRACING" ) );
 
@@ -118,7 +119,7 @@ void C3D_RENDER_RAYTRACING::SetCurWindowSize( const wxSize &aSize )
         m_windowSize = aSize;
         glViewport( 0, 0, m_windowSize.x, m_windowSize.y );
 
-        initializeNewWindowSize();
+        // The buffers are resized by the next Redraw(), which sees the new window size
     }
 }
 
@@ -166,6 +167,7 @@ bool C3D_RENDER_RAYTRACING::Redraw(
         // revert to preview mode the first time the Redraw is called
         m_oldWindowsSize = m_windowSize;
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
     std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
@@ -192,6 +194,7 @@ bool C3D_RENDER_RAYTRACING::Redraw(
         requestRedraw = true;
 
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
 
@@ -299,6 +302,34 @@ bool C3D_RENDER_RAYTRACING::Redraw(
 }
 
 
+void C3D_RENDER_RAYTRACING::RenderToBuffer( const wxSize& aSize, std::vector<GLubyte>& aBuffer,
+                                            REPORTER* aStatusTextReporter )
+{
+    // Only the CPU side buffers are needed, SetCurWindowSize() would set the OpenGL viewport
+    if( m_blockPositions.empty() || aSize != m_windowSize )
+    {
+        m_windowSize = aSize;
+        m_oldWindowsSize = m_windowSize;
+        initialize_block_positions();
+    }
+
+    if( m_reloadRequested )
+        reload( aStatusTextReporter, nullptr );
+
+    aBuffer.assign( m_realBufferSize.x * m_realBufferSize.y * 4, 0 );
+
+    // Restart from scratch and keep going until the last post processing step is done.
+    // Each render() call gives up after a short time to let the canvas display the progress,
+    // there is nothing to display here.
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( aBuffer.data(), aStatusTextReporter );
+    } while( m_rt_render_state != RT_RENDER_STATE_FINISH );
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -367,45 +398,31 @@ void C3D_RENDER_RAYTRACING::rt_render_tracing( GLubyte *ptrPBO ,
     m_isPreview = false;
 
     auto startTime = std::chrono::steady_clock::now();
-    bool breakLoop = false;
+    std::atomic<bool> breakLoop( false );
 
     std::atomic<size_t> numBlocksRendered( 0 );
     std::atomic<size_t> currentBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    m_workers.Run( [&]()
     {
-        std::thread t = std::thread( [&]()
+        for( size_t iBlock = currentBlock.fetch_add( 1 );
+                    iBlock < m_blockPositions.size() && !breakLoop;
+                    iBlock = currentBlock.fetch_add( 1 ) )
         {
-            for( size_t iBlock = currentBlock.fetch_add( 1 );
-                        iBlock < m_blockPositions.size() && !breakLoop;
-                        iBlock = currentBlock.fetch_add( 1 ) )
+            if( !m_blockPositionsWasProcessed[iBlock] )
             {
-                if( !m_blockPositionsWasProcessed[iBlock] )
-                {
-                    rt_render_trace_block( ptrPBO, iBlock );
-                    numBlocksRendered++;
-                    m_blockPositionsWasProcessed[iBlock] = 1;
-
-                    // Check if it spend already some time render and request to exit
-                    // to display the progress
-                    if( std::chrono::duration_cast<std::chrono::milliseconds>(
-                            std::chrono::steady_clock::now() - startTime ).count() > 150 )
-                        breakLoop = true;
-                }
+                rt_render_trace_block( ptrPBO, iBlock );
+                numBlocksRendered++;
+                m_blockPositionsWasProcessed[iBlock] = 1;
+
+                // Check if it spend already some time render and request to exit
+                // to display the progress
+                if( std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - startTime ).count() > 150 )
+                    breakLoop = true;
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
-    }
-
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+    } );
 
     m_nrBlocksRenderProgress += numBlocksRendered;
 
@@ -653,6 +670,78 @@ void C3D_RENDER_RAYTRACING::rt_trace_AA_packet( const SFVEC3F *aBgColorY,
 
 #define DISP_FACTOR 0.075f
 
+// Adaptive anti-aliasing: if the center sample of every pixel of a block differs less than
+// this from the four samples at the pixel corners (on each display channel), the block is
+// considered uniform and further samples are skipped
+#define AA_UNIFORM_BLOCK_THRESHOLD ( 1.0f / 255.0f )
+
+
+/**
+ * @return the color as it will be displayed, so that differences are measured in the
+ *         8-bit steps that are actually visible (a linear step near black is much larger)
+ */
+static SFVEC3F toDisplaySpace( const SFVEC3F& aColor )
+{
+#ifdef USE_SRGB_SPACE
+    return convertLinearToSRGB( aColor );
+#else
+    return glm::clamp( aColor, SFVEC3F( 0.0f ), SFVEC3F( 1.0f ) );
+#endif
+}
+
+
+static bool isCloseColor( const SFVEC3F& aColorA, const SFVEC3F& aColorB )
+{
+    const SFVEC3F diff = glm::abs( aColorA - aColorB );
+
+    return ( diff.r <= AA_UNIFORM_BLOCK_THRESHOLD ) &&
+           ( diff.g <= AA_UNIFORM_BLOCK_THRESHOLD ) &&
+           ( diff.b <= AA_UNIFORM_BLOCK_THRESHOLD );
+}
+
+
+/**
+ * @param aCornerSamples are the (0, 0) samples of the ray packet, one per pixel corner
+ * @param aCenterSamples are the (0.5, 0.5) samples of the ray packet
+ * @return true if every center sample is close to the corner samples around it, so the
+ *         block can skip supersampling
+ */
+static bool isUniformBlock( const SFVEC3F* aCornerSamples, const SFVEC3F* aCenterSamples )
+{
+    SFVEC3F corner[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        corner[i] = toDisplaySpace( aCornerSamples[i] );
+
+    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
+    {
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+        {
+            const SFVEC3F center = toDisplaySpace( aCenterSamples[i] );
+
+            // The right and bottom corners of the last column / row belong to the next
+            // blocks; like rt_trace_AA_packet, only the corners inside the packet are used
+            const bool hasRight = x < ( RAYPACKET_DIM - 1 );
+            const bool hasBottom = y < ( RAYPACKET_DIM - 1 );
+
+            if( !isCloseColor( center, corner[i] ) )
+                return false;
+
+            if( hasRight && !isCloseColor( center, corner[i + 1] ) )
+                return false;
+
+            if( hasBottom && !isCloseColor( center, corner[i + RAYPACKET_DIM] ) )
+                return false;
+
+            if( hasRight && hasBottom && !isCloseColor( center, corner[i + RAYPACKET_DIM + 1] ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
 void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                                                    signed int iBlock )
 {
@@ -782,63 +871,73 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                               );
         }
 
-        SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        if( isUniformBlock( hitColor_X0Y0, hitColor_AA_X1Y1 ) )
         {
-            const SFVEC3F color_average = ( hitColor_X0Y0[i] +
-                                            hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
-
-            hitColor_AA_X1Y0[i] = color_average;
-            hitColor_AA_X0Y1[i] = color_average;
-            hitColor_AA_X0Y1_half[i] = color_average;
+            // Nothing to anti-alias in this block (no edges nor noisy materials), so the
+            // remaining samples would not change the result
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] + hitColor_AA_X1Y1[i] ) * SFVEC3F( 0.5f );
         }
-
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        RAYPACKET_InitRays_with2DDisplacement( m_camera,
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y0 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_camera,
-                                               (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X0Y1 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_camera,
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y1_half );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y0,
-                            hitColor_AA_X1Y0 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X0Y1,
-                            hitColor_AA_X0Y1 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y1_half,
-                            hitColor_AA_X0Y1_half );
-
-        // Average the result
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        else
         {
-            hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
-                                 hitColor_AA_X1Y1[i] +
-                                 hitColor_AA_X1Y0[i] +
-                                 hitColor_AA_X0Y1[i] +
-                                 hitColor_AA_X0Y1_half[i]
-                                 ) * SFVEC3F(1.0f / 5.0f);
+            SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                const SFVEC3F color_average = ( hitColor_X0Y0[i] +
+                                                hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
+
+                hitColor_AA_X1Y0[i] = color_average;
+                hitColor_AA_X0Y1[i] = color_average;
+                hitColor_AA_X0Y1_half[i] = color_average;
+            }
+
+            RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            RAYPACKET_InitRays_with2DDisplacement( m_camera,
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y0 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_camera,
+                                                   (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X0Y1 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_camera,
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y1_half );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y0,
+                                hitColor_AA_X1Y0 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X0Y1,
+                                hitColor_AA_X0Y1 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y1_half,
+                                hitColor_AA_X0Y1_half );
+
+            // Average the result
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
+                                     hitColor_AA_X1Y1[i] +
+                                     hitColor_AA_X1Y0[i] +
+                                     hitColor_AA_X0Y1[i] +
+                                     hitColor_AA_X0Y1_half[i]
+                                     ) * SFVEC3F(1.0f / 5.0f);
+            }
         }
     }
 
@@ -917,34 +1016,22 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
             aStatusTextReporter->Report( _("Rendering: Post processing shader") );
 
         std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        m_workers.Run( [&]()
         {
-            std::thread t = std::thread( [&]()
+            for( size_t y = nextBlock.fetch_add( 1 );
+                        y < m_realBufferSize.y;
+                        y = nextBlock.fetch_add( 1 ) )
             {
-                for( size_t y = nextBlock.fetch_add( 1 );
-                            y < m_realBufferSize.y;
-                            y = nextBlock.fetch_add( 1 ) )
-                {
-                    SFVEC3F *ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
+                SFVEC3F *ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
-                    {
-                        *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
-                        ptr++;
-                    }
+                for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                {
+                    *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
+                    ptr++;
                 }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            }
+        } );
 
         // Set next state
         m_rt_render_state = RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH;
@@ -966,105 +1053,93 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_blur_finish( GLubyte *ptrPBO,
     {
         // Now blurs the shader result and compute the final color
         std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        m_workers.Run( [&]()
         {
-            std::thread t = std::thread( [&]()
+            for( size_t y = nextBlock.fetch_add( 1 );
+                        y < m_realBufferSize.y;
+                        y = nextBlock.fetch_add( 1 ) )
             {
-                for( size_t y = nextBlock.fetch_add( 1 );
-                            y < m_realBufferSize.y;
-                            y = nextBlock.fetch_add( 1 ) )
+                GLubyte *ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
+
+                const SFVEC3F *ptrShaderY0 =
+                        &m_shaderBuffer[ glm::max((int)y - 2, 0) * m_realBufferSize.x ];
+                const SFVEC3F *ptrShaderY1 =
+                        &m_shaderBuffer[ glm::max((int)y - 1, 0) * m_realBufferSize.x ];
+                const SFVEC3F *ptrShaderY2 =
+                        &m_shaderBuffer[ y * m_realBufferSize.x ];
+                const SFVEC3F *ptrShaderY3 =
+                        &m_shaderBuffer[ glm::min((int)y + 1, (int)(m_realBufferSize.y - 1)) *
+                                         m_realBufferSize.x ];
+                const SFVEC3F *ptrShaderY4 =
+                        &m_shaderBuffer[ glm::min((int)y + 2, (int)(m_realBufferSize.y - 1)) *
+                                         m_realBufferSize.x ];
+
+                for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
                 {
-                    GLubyte *ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
-
-                    const SFVEC3F *ptrShaderY0 =
-                            &m_shaderBuffer[ glm::max((int)y - 2, 0) * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY1 =
-                            &m_shaderBuffer[ glm::max((int)y - 1, 0) * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY2 =
-                            &m_shaderBuffer[ y * m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY3 =
-                            &m_shaderBuffer[ glm::min((int)y + 1, (int)(m_realBufferSize.y - 1)) *
-                                             m_realBufferSize.x ];
-                    const SFVEC3F *ptrShaderY4 =
-                            &m_shaderBuffer[ glm::min((int)y + 2, (int)(m_realBufferSize.y - 1)) *
-                                             m_realBufferSize.x ];
-
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
-                    {
-        // This #if should be 1, it is here that can be used for debug proposes during development
-        #if 1
-                        int idx = x > 1 ? -2 : 0;
-                        SFVEC3F bluredShadeColor = ptrShaderY0[idx] * 1.0f / 273.0f +
-                                                   ptrShaderY1[idx] * 4.0f / 273.0f +
-                                                   ptrShaderY2[idx] * 7.0f / 273.0f +
-                                                   ptrShaderY3[idx] * 4.0f / 273.0f +
-                                                   ptrShaderY4[idx] * 1.0f / 273.0f;
-
-                        idx = x > 0 ? -1 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] *  4.0f / 273.0f +
-                                            ptrShaderY1[idx] * 16.0f / 273.0f +
-                                            ptrShaderY2[idx] * 26.0f / 273.0f +
-                                            ptrShaderY3[idx] * 16.0f / 273.0f +
-                                            ptrShaderY4[idx] *  4.0f / 273.0f;
-
-                        bluredShadeColor += (*ptrShaderY0) *  7.0f / 273.0f +
-                                            (*ptrShaderY1) * 26.0f / 273.0f +
-                                            (*ptrShaderY2) * 41.0f / 273.0f +
-                                            (*ptrShaderY3) * 26.0f / 273.0f +
-                                            (*ptrShaderY4) *  7.0f / 273.0f;
-
-                        idx = (x < (int)m_realBufferSize.x - 1) ? 1 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] * 4.0f / 273.0f +
-                                            ptrShaderY1[idx] *16.0f / 273.0f +
-                                            ptrShaderY2[idx] *26.0f / 273.0f +
-                                            ptrShaderY3[idx] *16.0f / 273.0f +
-                                            ptrShaderY4[idx] * 4.0f / 273.0f;
-
-                        idx = (x < (int)m_realBufferSize.x - 2) ? 2 : 0;
-                        bluredShadeColor += ptrShaderY0[idx] * 1.0f / 273.0f +
-                                            ptrShaderY1[idx] * 4.0f / 273.0f +
-                                            ptrShaderY2[idx] * 7.0f / 273.0f +
-                                            ptrShaderY3[idx] * 4.0f / 273.0f +
-                                            ptrShaderY4[idx] * 1.0f / 273.0f;
-
-                        // process next pixel
-                        ++ptrShaderY0;
-                        ++ptrShaderY1;
-                        ++ptrShaderY2;
-                        ++ptrShaderY3;
-                        ++ptrShaderY4;
-
-        #ifdef USE_SRGB_SPACE
-                        const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
-        #else
-                        const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
-        #endif
-
-                        const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
-        #else
-                        // Debug code
-                        //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
-                        //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
-                        const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
-        #endif
-
-                        rt_final_color( ptr, shadedColor, false );
-
-                        ptr += 4;
-                    }
+    // This #if should be 1, it is here that can be used for debug proposes during development
+    #if 1
+                    int idx = x > 1 ? -2 : 0;
+                    SFVEC3F bluredShadeColor = ptrShaderY0[idx] * 1.0f / 273.0f +
+                                               ptrShaderY1[idx] * 4.0f / 273.0f +
+                                               ptrShaderY2[idx] * 7.0f / 273.0f +
+                                               ptrShaderY3[idx] * 4.0f / 273.0f +
+                                               ptrShaderY4[idx] * 1.0f / 273.0f;
+
+                    idx = x > 0 ? -1 : 0;
+                    bluredShadeColor += ptrShaderY0[idx] *  4.0f / 273.0f +
+                                        ptrShaderY1[idx] * 16.0f / 273.0f +
+                                        ptrShaderY2[idx] * 26.0f / 273.0f +
+                                        ptrShaderY3[idx] * 16.0f / 273.0f +
+                                        ptrShaderY4[idx] *  4.0f / 273.0f;
+
+                    bluredShadeColor += (*ptrShaderY0) *  7.0f / 273.0f +
+                                        (*ptrShaderY1) * 26.0f / 273.0f +
+                                        (*ptrShaderY2) * 41.0f / 273.0f +
+                                        (*ptrShaderY3) * 26.0f / 273.0f +
+                                        (*ptrShaderY4) *  7.0f / 273.0f;
+
+                    idx = (x < (int)m_realBufferSize.x - 1) ? 1 : 0;
+                    bluredShadeColor += ptrShaderY0[idx] * 4.0f / 273.0f +
+                                        ptrShaderY1[idx] *16.0f / 273.0f +
+                                        ptrShaderY2[idx] *26.0f / 273.0f +
+                                        ptrShaderY3[idx] *16.0f / 273.0f +
+                                        ptrShaderY4[idx] * 4.0f / 273.0f;
+
+                    idx = (x < (int)m_realBufferSize.x - 2) ? 2 : 0;
+                    bluredShadeColor += ptrShaderY0[idx] * 1.0f / 273.0f +
+                                        ptrShaderY1[idx] * 4.0f / 273.0f +
+                                        ptrShaderY2[idx] * 7.0f / 273.0f +
+                                        ptrShaderY3[idx] * 4.0f / 273.0f +
+                                        ptrShaderY4[idx] * 1.0f / 273.0f;
+
+                    // process next pixel
+                    ++ptrShaderY0;
+                    ++ptrShaderY1;
+                    ++ptrShaderY2;
+                    ++ptrShaderY3;
+                    ++ptrShaderY4;
+
+    #ifdef USE_SRGB_SPACE
+                    const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
+    #else
+                    const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
+    #endif
+
+                    const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
+    #else
+                    // Debug code
+                    //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
+                    //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
+                    const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
+    #endif
+
+                    rt_final_color( ptr, shadedColor, false );
+
+                    ptr += 4;
                 }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            }
+        } );
 
 
         // Debug code
@@ -1081,628 +1156,614 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
     m_isPreview = true;
 
     std::atomic<size_t> nextBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    m_workers.Run( [&]()
     {
-        std::thread t = std::thread( [&]()
+        for( size_t iBlock = nextBlock.fetch_add( 1 );
+                    iBlock < m_blockPositionsFast.size();
+                    iBlock = nextBlock.fetch_add( 1 ) )
         {
-            for( size_t iBlock = nextBlock.fetch_add( 1 );
-                        iBlock < m_blockPositionsFast.size();
-                        iBlock = nextBlock.fetch_add( 1 ) )
-            {
-                const SFVEC2UI &windowPosUI = m_blockPositionsFast[ iBlock ];
-                const SFVEC2I windowsPos = SFVEC2I( windowPosUI.x + m_xoffset,
-                                                    windowPosUI.y + m_yoffset );
+            const SFVEC2UI &windowPosUI = m_blockPositionsFast[ iBlock ];
+            const SFVEC2I windowsPos = SFVEC2I( windowPosUI.x + m_xoffset,
+                                                windowPosUI.y + m_yoffset );
 
-                RAYPACKET blockPacket( m_camera, windowsPos, 4 );
+            RAYPACKET blockPacket( m_camera, windowsPos, 4 );
 
-                HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
-
-                // Initialize hitPacket with a "not hit" information
-                for( HITINFO_PACKET& packet : hitPacket )
-                {
-                    packet.m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
-                    packet.m_HitInfo.m_acc_node_info = 0;
-                    packet.m_hitresult = false;
-                }
-
-                //  Intersect packet block
-                m_accelerator->Intersect( blockPacket, hitPacket );
+            HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
 
+            // Initialize hitPacket with a "not hit" information
+            for( HITINFO_PACKET& packet : hitPacket )
+            {
+                packet.m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                packet.m_HitInfo.m_acc_node_info = 0;
+                packet.m_hitresult = false;
+            }
 
-                // Calculate background gradient color
-                // /////////////////////////////////////////////////////////////////////
-                SFVEC3F bgColor[RAYPACKET_DIM];
+            //  Intersect packet block
+            m_accelerator->Intersect( blockPacket, hitPacket );
 
-                for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
-                {
-                    const float posYfactor = (float)(windowsPos.y + y * 4.0f) / (float)m_windowSize.y;
 
-                    bgColor[y] = (SFVEC3F)m_boardAdapter.m_BgColorTop * SFVEC3F( posYfactor) +
-                                 (SFVEC3F)m_boardAdapter.m_BgColorBot * ( SFVEC3F( 1.0f) - SFVEC3F( posYfactor) );
-                }
+            // Calculate background gradient color
+            // /////////////////////////////////////////////////////////////////////
+            SFVEC3F bgColor[RAYPACKET_DIM];
 
-                CCOLORRGB hitColorShading[RAYPACKET_RAYS_PER_PACKET];
+            for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
+            {
+                const float posYfactor = (float)(windowsPos.y + y * 4.0f) / (float)m_windowSize.y;
 
-                for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-                {
-                    const SFVEC3F bhColorY = bgColor[i / RAYPACKET_DIM];
+                bgColor[y] = (SFVEC3F)m_boardAdapter.m_BgColorTop * SFVEC3F( posYfactor) +
+                             (SFVEC3F)m_boardAdapter.m_BgColorBot * ( SFVEC3F( 1.0f) - SFVEC3F( posYfactor) );
+            }
 
-                    if( hitPacket[i].m_hitresult == true )
-                    {
-                        const SFVEC3F hitColor = shadeHit( bhColorY,
-                                                           blockPacket.m_ray[i],
-                                                           hitPacket[i].m_HitInfo,
-                                                           false,
-                                                           0,
-                                                           false );
-
-                        hitColorShading[i] = CCOLORRGB( hitColor );
-                    }
-                    else
-                        hitColorShading[i] = bhColorY;
-                }
+            CCOLORRGB hitColorShading[RAYPACKET_RAYS_PER_PACKET];
 
-                CCOLORRGB cLRB_old[(RAYPACKET_DIM - 1)];
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                const SFVEC3F bhColorY = bgColor[i / RAYPACKET_DIM];
 
-                for( unsigned int y = 0; y < (RAYPACKET_DIM - 1); ++y )
+                if( hitPacket[i].m_hitresult == true )
                 {
+                    const SFVEC3F hitColor = shadeHit( bhColorY,
+                                                       blockPacket.m_ray[i],
+                                                       hitPacket[i].m_HitInfo,
+                                                       false,
+                                                       0,
+                                                       false );
+
+                    hitColorShading[i] = CCOLORRGB( hitColor );
+                }
+                else
+                    hitColorShading[i] = bhColorY;
+            }
 
-                    const SFVEC3F     bgColorY = bgColor[y];
-                    const CCOLORRGB   bgColorYRGB = CCOLORRGB( bgColorY );
-
-                    // This stores cRTB from the last block to be reused next time in a cLTB pixel
-                    CCOLORRGB cRTB_old;
+            CCOLORRGB cLRB_old[(RAYPACKET_DIM - 1)];
 
-                    //RAY       cRTB_ray;
-                    //HITINFO   cRTB_hitInfo;
+            for( unsigned int y = 0; y < (RAYPACKET_DIM - 1); ++y )
+            {
 
-                    for( unsigned int x = 0; x < (RAYPACKET_DIM - 1); ++x )
-                    {
-                        //      pxl 0  pxl 1  pxl 2  pxl 3  pxl 4
-                        //        x0                          x1  ...
-                        //     .---------------------------.
-                        // y0  | cLT  | cxxx | cLRT | cxxx | cRT  |
-                        //     | cxxx | cLTC | cxxx | cRTC | cxxx |
-                        //     | cLTB | cxxx | cC   | cxxx | cRTB |
-                        //     | cxxx | cLBC | cxxx | cRBC | cxxx |
-                        //     '---------------------------'
-                        // y1  | cLB  | cxxx | cLRB | cxxx | cRB  |
+                const SFVEC3F     bgColorY = bgColor[y];
+                const CCOLORRGB   bgColorYRGB = CCOLORRGB( bgColorY );
 
-                        const unsigned int iLT = ((x + 0) + RAYPACKET_DIM * (y + 0));
-                        const unsigned int iRT = ((x + 1) + RAYPACKET_DIM * (y + 0));
-                        const unsigned int iLB = ((x + 0) + RAYPACKET_DIM * (y + 1));
-                        const unsigned int iRB = ((x + 1) + RAYPACKET_DIM * (y + 1));
+                // This stores cRTB from the last block to be reused next time in a cLTB pixel
+                CCOLORRGB cRTB_old;
 
-                        // !TODO: skip when there are no hits
+                //RAY       cRTB_ray;
+                //HITINFO   cRTB_hitInfo;
 
+                for( unsigned int x = 0; x < (RAYPACKET_DIM - 1); ++x )
+                {
+                    //      pxl 0  pxl 1  pxl 2  pxl 3  pxl 4
+                    //        x0                          x1  ...
+                    //     .---------------------------.
+                    // y0  | cLT  | cxxx | cLRT | cxxx | cRT  |
+                    //     | cxxx | cLTC | cxxx | cRTC | cxxx |
+                    //     | cLTB | cxxx | cC   | cxxx | cRTB |
+                    //     | cxxx | cLBC | cxxx | cRBC | cxxx |
+                    //     '---------------------------'
+                    // y1  | cLB  | cxxx | cLRB | cxxx | cRB  |
 
-                        const CCOLORRGB &cLT = hitColorShading[ iLT ];
-                        const CCOLORRGB &cRT = hitColorShading[ iRT ];
-                        const CCOLORRGB &cLB = hitColorShading[ iLB ];
-                        const CCOLORRGB &cRB = hitColorShading[ iRB ];
+                    const unsigned int iLT = ((x + 0) + RAYPACKET_DIM * (y + 0));
+                    const unsigned int iRT = ((x + 1) + RAYPACKET_DIM * (y + 0));
+                    const unsigned int iLB = ((x + 0) + RAYPACKET_DIM * (y + 1));
+                    const unsigned int iRB = ((x + 1) + RAYPACKET_DIM * (y + 1));
 
-                        // Trace and shade cC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cC = bgColorYRGB;
+                    // !TODO: skip when there are no hits
 
-                        const SFVEC3F &oriLT = blockPacket.m_ray[ iLT ].m_Origin;
-                        const SFVEC3F &oriRB = blockPacket.m_ray[ iRB ].m_Origin;
 
-                        const SFVEC3F &dirLT = blockPacket.m_ray[ iLT ].m_Dir;
-                        const SFVEC3F &dirRB = blockPacket.m_ray[ iRB ].m_Dir;
+                    const CCOLORRGB &cLT = hitColorShading[ iLT ];
+                    const CCOLORRGB &cRT = hitColorShading[ iRT ];
+                    const CCOLORRGB &cLB = hitColorShading[ iLB ];
+                    const CCOLORRGB &cRB = hitColorShading[ iRB ];
 
-                        SFVEC3F oriC;
-                        SFVEC3F dirC;
+                    // Trace and shade cC
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cC = bgColorYRGB;
 
-                        HITINFO centerHitInfo;
-                        centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                    const SFVEC3F &oriLT = blockPacket.m_ray[ iLT ].m_Origin;
+                    const SFVEC3F &oriRB = blockPacket.m_ray[ iRB ].m_Origin;
 
-                        bool hittedC = false;
+                    const SFVEC3F &dirLT = blockPacket.m_ray[ iLT ].m_Dir;
+                    const SFVEC3F &dirRB = blockPacket.m_ray[ iRB ].m_Dir;
 
-                        if( (hitPacket[ iLT ].m_hitresult == true) ||
-                            (hitPacket[ iRT ].m_hitresult == true) ||
-                            (hitPacket[ iLB ].m_hitresult == true) ||
-                            (hitPacket[ iRB ].m_hitresult == true) )
-                        {
+                    SFVEC3F oriC;
+                    SFVEC3F dirC;
 
-                            oriC = ( oriLT + oriRB ) * 0.5f;
-                            dirC = glm::normalize( ( dirLT + dirRB ) * 0.5f );
+                    HITINFO centerHitInfo;
+                    centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
 
-                            // Trace the center ray
-                            RAY centerRay;
-                            centerRay.Init( oriC, dirC );
+                    bool hittedC = false;
 
-                            const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
-                            const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
-                            const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
-                            const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
-
-                            if( nodeLT != 0 )
-                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLT );
-
-                            if( ( nodeRT != 0 ) &&
-                                ( nodeRT != nodeLT ) )
-                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRT );
+                    if( (hitPacket[ iLT ].m_hitresult == true) ||
+                        (hitPacket[ iRT ].m_hitresult == true) ||
+                        (hitPacket[ iLB ].m_hitresult == true) ||
+                        (hitPacket[ iRB ].m_hitresult == true) )
+                    {
 
-                            if( ( nodeLB != 0 ) &&
-                                ( nodeLB != nodeLT ) &&
-                                ( nodeLB != nodeRT ) )
-                                    hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLB );
+                        oriC = ( oriLT + oriRB ) * 0.5f;
+                        dirC = glm::normalize( ( dirLT + dirRB ) * 0.5f );
 
-                            if( ( nodeRB != 0 ) &&
-                                ( nodeRB != nodeLB ) &&
-                                ( nodeRB != nodeLT ) &&
-                                ( nodeRB != nodeRT ) )
-                                    hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRB );
+                        // Trace the center ray
+                        RAY centerRay;
+                        centerRay.Init( oriC, dirC );
+
+                        const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
+                        const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+                        const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
+                        const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+
+                        if( nodeLT != 0 )
+                            hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLT );
+
+                        if( ( nodeRT != 0 ) &&
+                            ( nodeRT != nodeLT ) )
+                            hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRT );
+
+                        if( ( nodeLB != 0 ) &&
+                            ( nodeLB != nodeLT ) &&
+                            ( nodeLB != nodeRT ) )
+                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeLB );
+
+                        if( ( nodeRB != 0 ) &&
+                            ( nodeRB != nodeLB ) &&
+                            ( nodeRB != nodeLT ) &&
+                            ( nodeRB != nodeRT ) )
+                                hittedC |= m_accelerator->Intersect( centerRay, centerHitInfo, nodeRB );
+
+                        if( hittedC )
+                            cC = CCOLORRGB( shadeHit( bgColorY, centerRay, centerHitInfo, false, 0, false ) );
+                        else
+                        {
+                            centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                            hittedC = m_accelerator->Intersect( centerRay, centerHitInfo );
 
                             if( hittedC )
-                                cC = CCOLORRGB( shadeHit( bgColorY, centerRay, centerHitInfo, false, 0, false ) );
-                            else
-                            {
-                                centerHitInfo.m_tHit = std::numeric_limits<float>::infinity();
-                                hittedC = m_accelerator->Intersect( centerRay, centerHitInfo );
-
-                                if( hittedC )
-                                    cC = CCOLORRGB( shadeHit( bgColorY,
-                                                              centerRay,
-                                                              centerHitInfo,
-                                                              false,
-                                                              0,
-                                                              false ) );
-                            }
+                                cC = CCOLORRGB( shadeHit( bgColorY,
+                                                          centerRay,
+                                                          centerHitInfo,
+                                                          false,
+                                                          0,
+                                                          false ) );
                         }
+                    }
 
-                        // Trace and shade cLRT
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLRT = bgColorYRGB;
+                    // Trace and shade cLRT
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cLRT = bgColorYRGB;
 
-                        const SFVEC3F &oriRT = blockPacket.m_ray[ iRT ].m_Origin;
-                        const SFVEC3F &dirRT = blockPacket.m_ray[ iRT ].m_Dir;
+                    const SFVEC3F &oriRT = blockPacket.m_ray[ iRT ].m_Origin;
+                    const SFVEC3F &dirRT = blockPacket.m_ray[ iRT ].m_Dir;
 
-                        if( y == 0 )
-                        {
-                            // Trace the center ray
-                            RAY rayLRT;
-                            rayLRT.Init( ( oriLT + oriRT ) * 0.5f,
-                                            glm::normalize( ( dirLT + dirRT ) * 0.5f ) );
+                    if( y == 0 )
+                    {
+                        // Trace the center ray
+                        RAY rayLRT;
+                        rayLRT.Init( ( oriLT + oriRT ) * 0.5f,
+                                        glm::normalize( ( dirLT + dirRT ) * 0.5f ) );
 
-                            HITINFO hitInfoLRT;
-                            hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoLRT;
+                        hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hitPacket[ iLT ].m_hitresult &&
-                                hitPacket[ iRT ].m_hitresult &&
-                                (hitPacket[ iLT ].m_HitInfo.pHitObject == hitPacket[ iRT ].m_HitInfo.pHitObject) )
-                            {
-                                hitInfoLRT.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
-                                hitInfoLRT.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
-                                                      hitPacket[ iRT ].m_HitInfo.m_tHit ) * 0.5f;
-                                hitInfoLRT.m_HitNormal =
-                                        glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
-                                                          hitPacket[ iRT ].m_HitInfo.m_HitNormal ) * 0.5f );
-
-                                cLRT = CCOLORRGB( shadeHit( bgColorY, rayLRT, hitInfoLRT, false, 0, false ) );
-                                cLRT = BlendColor( cLRT, BlendColor( cLT, cRT) );
-                            }
-                            else
+                        if( hitPacket[ iLT ].m_hitresult &&
+                            hitPacket[ iRT ].m_hitresult &&
+                            (hitPacket[ iLT ].m_HitInfo.pHitObject == hitPacket[ iRT ].m_HitInfo.pHitObject) )
+                        {
+                            hitInfoLRT.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                            hitInfoLRT.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
+                                                  hitPacket[ iRT ].m_HitInfo.m_tHit ) * 0.5f;
+                            hitInfoLRT.m_HitNormal =
+                                    glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
+                                                      hitPacket[ iRT ].m_HitInfo.m_HitNormal ) * 0.5f );
+
+                            cLRT = CCOLORRGB( shadeHit( bgColorY, rayLRT, hitInfoLRT, false, 0, false ) );
+                            cLRT = BlendColor( cLRT, BlendColor( cLT, cRT) );
+                        }
+                        else
+                        {
+                            if( hitPacket[ iLT ].m_hitresult ||
+                                hitPacket[ iRT ].m_hitresult )                  // If any hits
                             {
-                                if( hitPacket[ iLT ].m_hitresult ||
-                                    hitPacket[ iRT ].m_hitresult )                  // If any hits
-                                {
-                                    const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
-                                    const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+                                const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
+                                const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+
+                                bool hittedLRT = false;
 
-                                    bool hittedLRT = false;
+                                if( nodeLT != 0 )
+                                    hittedLRT |= m_accelerator->Intersect( rayLRT, hitInfoLRT, nodeLT );
 
-                                    if( nodeLT != 0 )
-                                        hittedLRT |= m_accelerator->Intersect( rayLRT, hitInfoLRT, nodeLT );
+                                if( ( nodeRT != 0 ) &&
+                                    ( nodeRT != nodeLT ) )
+                                    hittedLRT |= m_accelerator->Intersect( rayLRT,
+                                                                           hitInfoLRT,
+                                                                           nodeRT );
 
-                                    if( ( nodeRT != 0 ) &&
-                                        ( nodeRT != nodeLT ) )
-                                        hittedLRT |= m_accelerator->Intersect( rayLRT,
-                                                                               hitInfoLRT,
-                                                                               nodeRT );
+                                if( hittedLRT )
+                                    cLRT = CCOLORRGB( shadeHit( bgColorY,
+                                                                rayLRT,
+                                                                hitInfoLRT,
+                                                                false,
+                                                                0,
+                                                                false ) );
+                                else
+                                {
+                                    hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
 
-                                    if( hittedLRT )
+                                    if( m_accelerator->Intersect( rayLRT,hitInfoLRT ) )
                                         cLRT = CCOLORRGB( shadeHit( bgColorY,
                                                                     rayLRT,
                                                                     hitInfoLRT,
                                                                     false,
                                                                     0,
                                                                     false ) );
-                                    else
-                                    {
-                                        hitInfoLRT.m_tHit = std::numeric_limits<float>::infinity();
-
-                                        if( m_accelerator->Intersect( rayLRT,hitInfoLRT ) )
-                                            cLRT = CCOLORRGB( shadeHit( bgColorY,
-                                                                        rayLRT,
-                                                                        hitInfoLRT,
-                                                                        false,
-                                                                        0,
-                                                                        false ) );
-                                    }
                                 }
                             }
                         }
-                        else
-                            cLRT = cLRB_old[x];
+                    }
+                    else
+                        cLRT = cLRB_old[x];
 
 
-                        // Trace and shade cLTB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLTB = bgColorYRGB;
+                    // Trace and shade cLTB
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cLTB = bgColorYRGB;
 
-                        if( x == 0 )
-                        {
-                            const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
-                            const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
+                    if( x == 0 )
+                    {
+                        const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
+                        const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
 
-                            // Trace the center ray
-                            RAY rayLTB;
-                            rayLTB.Init( ( oriLT + oriLB ) * 0.5f,
-                                            glm::normalize( ( dirLT + dirLB ) * 0.5f ) );
+                        // Trace the center ray
+                        RAY rayLTB;
+                        rayLTB.Init( ( oriLT + oriLB ) * 0.5f,
+                                        glm::normalize( ( dirLT + dirLB ) * 0.5f ) );
 
-                            HITINFO hitInfoLTB;
-                            hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoLTB;
+                        hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
 
-                            if( hitPacket[ iLT ].m_hitresult &&
-                                hitPacket[ iLB ].m_hitresult &&
-                                ( hitPacket[ iLT ].m_HitInfo.pHitObject ==
-                                  hitPacket[ iLB ].m_HitInfo.pHitObject ) )
-                            {
-                                hitInfoLTB.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
-                                hitInfoLTB.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
-                                                      hitPacket[ iLB ].m_HitInfo.m_tHit ) * 0.5f;
-                                hitInfoLTB.m_HitNormal =
-                                        glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
-                                                          hitPacket[ iLB ].m_HitInfo.m_HitNormal ) * 0.5f );
-                                cLTB = CCOLORRGB( shadeHit( bgColorY, rayLTB, hitInfoLTB, false, 0, false ) );
-                                cLTB = BlendColor( cLTB, BlendColor( cLT, cLB) );
-                            }
-                            else
+                        if( hitPacket[ iLT ].m_hitresult &&
+                            hitPacket[ iLB ].m_hitresult &&
+                            ( hitPacket[ iLT ].m_HitInfo.pHitObject ==
+                              hitPacket[ iLB ].m_HitInfo.pHitObject ) )
+                        {
+                            hitInfoLTB.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                            hitInfoLTB.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
+                                                  hitPacket[ iLB ].m_HitInfo.m_tHit ) * 0.5f;
+                            hitInfoLTB.m_HitNormal =
+                                    glm::normalize( ( hitPacket[ iLT ].m_HitInfo.m_HitNormal +
+                                                      hitPacket[ iLB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                            cLTB = CCOLORRGB( shadeHit( bgColorY, rayLTB, hitInfoLTB, false, 0, false ) );
+                            cLTB = BlendColor( cLTB, BlendColor( cLT, cLB) );
+                        }
+                        else
+                        {
+                            if( hitPacket[ iLT ].m_hitresult ||
+                                hitPacket[ iLB ].m_hitresult )                  // If any hits
                             {
-                                if( hitPacket[ iLT ].m_hitresult ||
-                                    hitPacket[ iLB ].m_hitresult )                  // If any hits
-                                {
-                                    const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
-                                    const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
+                                const unsigned int nodeLT = hitPacket[ iLT ].m_HitInfo.m_acc_node_info;
+                                const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
 
-                                    bool hittedLTB = false;
+                                bool hittedLTB = false;
 
-                                    if( nodeLT != 0 )
-                                        hittedLTB |= m_accelerator->Intersect( rayLTB,
-                                                                               hitInfoLTB,
-                                                                               nodeLT );
+                                if( nodeLT != 0 )
+                                    hittedLTB |= m_accelerator->Intersect( rayLTB,
+                                                                           hitInfoLTB,
+                                                                           nodeLT );
 
-                                    if( ( nodeLB != 0 ) &&
-                                        ( nodeLB != nodeLT ) )
-                                        hittedLTB |= m_accelerator->Intersect( rayLTB,
-                                                                               hitInfoLTB,
-                                                                               nodeLB );
+                                if( ( nodeLB != 0 ) &&
+                                    ( nodeLB != nodeLT ) )
+                                    hittedLTB |= m_accelerator->Intersect( rayLTB,
+                                                                           hitInfoLTB,
+                                                                           nodeLB );
 
-                                    if( hittedLTB )
+                                if( hittedLTB )
+                                    cLTB = CCOLORRGB( shadeHit( bgColorY,
+                                                                rayLTB,
+                                                                hitInfoLTB,
+                                                                false,
+                                                                0,
+                                                                false ) );
+                                else
+                                {
+                                    hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
+
+                                    if( m_accelerator->Intersect( rayLTB, hitInfoLTB ) )
                                         cLTB = CCOLORRGB( shadeHit( bgColorY,
                                                                     rayLTB,
                                                                     hitInfoLTB,
                                                                     false,
                                                                     0,
                                                                     false ) );
-                                    else
-                                    {
-                                        hitInfoLTB.m_tHit = std::numeric_limits<float>::infinity();
-
-                                        if( m_accelerator->Intersect( rayLTB, hitInfoLTB ) )
-                                            cLTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                        rayLTB,
-                                                                        hitInfoLTB,
-                                                                        false,
-                                                                        0,
-                                                                        false ) );
-                                    }
                                 }
                             }
                         }
-                        else
-                            cLTB = cRTB_old;
+                    }
+                    else
+                        cLTB = cRTB_old;
 
 
-                        // Trace and shade cRTB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRTB = bgColorYRGB;
+                    // Trace and shade cRTB
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cRTB = bgColorYRGB;
 
-                        // Trace the center ray
-                        RAY rayRTB;
-                        rayRTB.Init( ( oriRT + oriRB ) * 0.5f,
-                                        glm::normalize( ( dirRT + dirRB ) * 0.5f ) );
+                    // Trace the center ray
+                    RAY rayRTB;
+                    rayRTB.Init( ( oriRT + oriRB ) * 0.5f,
+                                    glm::normalize( ( dirRT + dirRB ) * 0.5f ) );
 
-                        HITINFO hitInfoRTB;
-                        hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
+                    HITINFO hitInfoRTB;
+                    hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
 
-                        if( hitPacket[ iRT ].m_hitresult &&
-                            hitPacket[ iRB ].m_hitresult &&
-                            ( hitPacket[ iRT ].m_HitInfo.pHitObject ==
-                              hitPacket[ iRB ].m_HitInfo.pHitObject ) )
-                        {
-                            hitInfoRTB.pHitObject = hitPacket[ iRT ].m_HitInfo.pHitObject;
+                    if( hitPacket[ iRT ].m_hitresult &&
+                        hitPacket[ iRB ].m_hitresult &&
+                        ( hitPacket[ iRT ].m_HitInfo.pHitObject ==
+                          hitPacket[ iRB ].m_HitInfo.pHitObject ) )
+                    {
+                        hitInfoRTB.pHitObject = hitPacket[ iRT ].m_HitInfo.pHitObject;
 
-                            hitInfoRTB.m_tHit = ( hitPacket[ iRT ].m_HitInfo.m_tHit +
-                                                  hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
+                        hitInfoRTB.m_tHit = ( hitPacket[ iRT ].m_HitInfo.m_tHit +
+                                              hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
 
-                            hitInfoRTB.m_HitNormal =
-                                    glm::normalize( ( hitPacket[ iRT ].m_HitInfo.m_HitNormal +
-                                                      hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                        hitInfoRTB.m_HitNormal =
+                                glm::normalize( ( hitPacket[ iRT ].m_HitInfo.m_HitNormal +
+                                                  hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
 
-                            cRTB = CCOLORRGB( shadeHit( bgColorY, rayRTB, hitInfoRTB, false, 0, false ) );
-                            cRTB = BlendColor( cRTB, BlendColor( cRT, cRB) );
-                        }
-                        else
+                        cRTB = CCOLORRGB( shadeHit( bgColorY, rayRTB, hitInfoRTB, false, 0, false ) );
+                        cRTB = BlendColor( cRTB, BlendColor( cRT, cRB) );
+                    }
+                    else
+                    {
+                        if( hitPacket[ iRT ].m_hitresult ||
+                            hitPacket[ iRB ].m_hitresult )                  // If any hits
                         {
-                            if( hitPacket[ iRT ].m_hitresult ||
-                                hitPacket[ iRB ].m_hitresult )                  // If any hits
-                            {
-                                const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
-                                const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+                            const unsigned int nodeRT = hitPacket[ iRT ].m_HitInfo.m_acc_node_info;
+                            const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
 
-                                bool hittedRTB = false;
+                            bool hittedRTB = false;
 
-                                if( nodeRT != 0 )
-                                    hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRT );
+                            if( nodeRT != 0 )
+                                hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRT );
 
-                                if( ( nodeRB != 0 ) &&
-                                    ( nodeRB != nodeRT ) )
-                                    hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRB );
+                            if( ( nodeRB != 0 ) &&
+                                ( nodeRB != nodeRT ) )
+                                hittedRTB |= m_accelerator->Intersect( rayRTB, hitInfoRTB, nodeRB );
+
+                            if( hittedRTB )
+                                cRTB = CCOLORRGB( shadeHit( bgColorY,
+                                                            rayRTB,
+                                                            hitInfoRTB,
+                                                            false,
+                                                            0,
+                                                            false) );
+                            else
+                            {
+                                hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
 
-                                if( hittedRTB )
+                                if( m_accelerator->Intersect( rayRTB, hitInfoRTB ) )
                                     cRTB = CCOLORRGB( shadeHit( bgColorY,
                                                                 rayRTB,
                                                                 hitInfoRTB,
                                                                 false,
                                                                 0,
-                                                                false) );
-                                else
-                                {
-                                    hitInfoRTB.m_tHit = std::numeric_limits<float>::infinity();
-
-                                    if( m_accelerator->Intersect( rayRTB, hitInfoRTB ) )
-                                        cRTB = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayRTB,
-                                                                    hitInfoRTB,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                }
+                                                                false ) );
                             }
                         }
+                    }
 
-                        cRTB_old = cRTB;
+                    cRTB_old = cRTB;
 
 
-                        // Trace and shade cLRB
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLRB = bgColorYRGB;
+                    // Trace and shade cLRB
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cLRB = bgColorYRGB;
 
-                        const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
-                        const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
+                    const SFVEC3F &oriLB = blockPacket.m_ray[ iLB ].m_Origin;
+                    const SFVEC3F &dirLB = blockPacket.m_ray[ iLB ].m_Dir;
 
-                        // Trace the center ray
-                        RAY rayLRB;
-                        rayLRB.Init( ( oriLB + oriRB ) * 0.5f,
-                                        glm::normalize( ( dirLB + dirRB ) * 0.5f ) );
+                    // Trace the center ray
+                    RAY rayLRB;
+                    rayLRB.Init( ( oriLB + oriRB ) * 0.5f,
+                                    glm::normalize( ( dirLB + dirRB ) * 0.5f ) );
 
-                        HITINFO hitInfoLRB;
-                        hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
+                    HITINFO hitInfoLRB;
+                    hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
 
-                        if( hitPacket[ iLB ].m_hitresult &&
-                            hitPacket[ iRB ].m_hitresult &&
-                            ( hitPacket[ iLB ].m_HitInfo.pHitObject ==
-                              hitPacket[ iRB ].m_HitInfo.pHitObject ) )
-                        {
-                            hitInfoLRB.pHitObject = hitPacket[ iLB ].m_HitInfo.pHitObject;
+                    if( hitPacket[ iLB ].m_hitresult &&
+                        hitPacket[ iRB ].m_hitresult &&
+                        ( hitPacket[ iLB ].m_HitInfo.pHitObject ==
+                          hitPacket[ iRB ].m_HitInfo.pHitObject ) )
+                    {
+                        hitInfoLRB.pHitObject = hitPacket[ iLB ].m_HitInfo.pHitObject;
 
-                            hitInfoLRB.m_tHit = ( hitPacket[ iLB ].m_HitInfo.m_tHit +
-                                                  hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
+                        hitInfoLRB.m_tHit = ( hitPacket[ iLB ].m_HitInfo.m_tHit +
+                                              hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
 
-                            hitInfoLRB.m_HitNormal =
-                                    glm::normalize( ( hitPacket[ iLB ].m_HitInfo.m_HitNormal +
-                                                      hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
+                        hitInfoLRB.m_HitNormal =
+                                glm::normalize( ( hitPacket[ iLB ].m_HitInfo.m_HitNormal +
+                                                  hitPacket[ iRB ].m_HitInfo.m_HitNormal ) * 0.5f );
 
-                            cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
-                            cLRB = BlendColor( cLRB, BlendColor( cLB, cRB) );
-                        }
-                        else
+                        cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
+                        cLRB = BlendColor( cLRB, BlendColor( cLB, cRB) );
+                    }
+                    else
+                    {
+                        if( hitPacket[ iLB ].m_hitresult ||
+                            hitPacket[ iRB ].m_hitresult )                  // If any hits
                         {
-                            if( hitPacket[ iLB ].m_hitresult ||
-                                hitPacket[ iRB ].m_hitresult )                  // If any hits
-                            {
-                                const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
-                                const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
+                            const unsigned int nodeLB = hitPacket[ iLB ].m_HitInfo.m_acc_node_info;
+                            const unsigned int nodeRB = hitPacket[ iRB ].m_HitInfo.m_acc_node_info;
 
-                                bool hittedLRB = false;
+                            bool hittedLRB = false;
 
-                                if( nodeLB != 0 )
-                                    hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeLB );
+                            if( nodeLB != 0 )
+                                hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeLB );
 
-                                if( ( nodeRB != 0 ) &&
-                                    ( nodeRB != nodeLB ) )
-                                    hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeRB );
+                            if( ( nodeRB != 0 ) &&
+                                ( nodeRB != nodeLB ) )
+                                hittedLRB |= m_accelerator->Intersect( rayLRB, hitInfoLRB, nodeRB );
 
-                                if( hittedLRB )
-                                    cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
-                                else
-                                {
-                                    hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
+                            if( hittedLRB )
+                                cLRB = CCOLORRGB( shadeHit( bgColorY, rayLRB, hitInfoLRB, false, 0, false ) );
+                            else
+                            {
+                                hitInfoLRB.m_tHit = std::numeric_limits<float>::infinity();
 
-                                    if( m_accelerator->Intersect( rayLRB, hitInfoLRB ) )
-                                        cLRB = CCOLORRGB( shadeHit( bgColorY,
-                                                                    rayLRB,
-                                                                    hitInfoLRB,
-                                                                    false,
-                                                                    0,
-                                                                    false ) );
-                                }
+                                if( m_accelerator->Intersect( rayLRB, hitInfoLRB ) )
+                                    cLRB = CCOLORRGB( shadeHit( bgColorY,
+                                                                rayLRB,
+                                                                hitInfoLRB,
+                                                                false,
+                                                                0,
+                                                                false ) );
                             }
                         }
+                    }
 
-                        cLRB_old[x] = cLRB;
+                    cLRB_old[x] = cLRB;
 
 
-                        // Trace and shade cLTC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLTC = BlendColor( cLT , cC );
+                    // Trace and shade cLTC
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cLTC = BlendColor( cLT , cC );
 
-                        if( hitPacket[ iLT ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayLTC;
-                            rayLTC.Init( ( oriLT + oriC ) * 0.5f,
-                                         glm::normalize( ( dirLT + dirC ) * 0.5f ) );
+                    if( hitPacket[ iLT ].m_hitresult || hittedC )
+                    {
+                        // Trace the center ray
+                        RAY rayLTC;
+                        rayLTC.Init( ( oriLT + oriC ) * 0.5f,
+                                     glm::normalize( ( dirLT + dirC ) * 0.5f ) );
 
-                            HITINFO hitInfoLTC;
-                            hitInfoLTC.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoLTC;
+                        hitInfoLTC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            bool hitted = false;
+                        bool hitted = false;
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLTC, hitInfoLTC );
-                            else
-                                if( hitPacket[ iLT ].m_hitresult )
-                                    hitted = hitPacket[ iLT ].m_HitInfo.pHitObject->Intersect( rayLTC,
-                                                                                               hitInfoLTC );
+                        if( hittedC )
+                            hitted = centerHitInfo.pAccObject->Intersect( rayLTC, hitInfoLTC );
+                        else
+                            if( hitPacket[ iLT ].m_hitresult )
+                                hitted = hitPacket[ iLT ].m_HitInfo.pAccObject->Intersect( rayLTC,
+                                                                                           hitInfoLTC );
 
-                            if( hitted )
-                                cLTC = CCOLORRGB( shadeHit( bgColorY, rayLTC, hitInfoLTC, false, 0, false ) );
-                        }
+                        if( hitted )
+                            cLTC = CCOLORRGB( shadeHit( bgColorY, rayLTC, hitInfoLTC, false, 0, false ) );
+                    }
 
 
-                        // Trace and shade cRTC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRTC = BlendColor( cRT , cC );
+                    // Trace and shade cRTC
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cRTC = BlendColor( cRT , cC );
 
-                        if( hitPacket[ iRT ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayRTC;
-                            rayRTC.Init( ( oriRT + oriC ) * 0.5f,
-                                         glm::normalize( ( dirRT + dirC ) * 0.5f ) );
+                    if( hitPacket[ iRT ].m_hitresult || hittedC )
+                    {
+                        // Trace the center ray
+                        RAY rayRTC;
+                        rayRTC.Init( ( oriRT + oriC ) * 0.5f,
+                                     glm::normalize( ( dirRT + dirC ) * 0.5f ) );
 
-                            HITINFO hitInfoRTC;
-                            hitInfoRTC.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoRTC;
+                        hitInfoRTC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            bool hitted = false;
+                        bool hitted = false;
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRTC, hitInfoRTC );
-                            else
-                                if( hitPacket[ iRT ].m_hitresult )
-                                    hitted = hitPacket[ iRT ].m_HitInfo.pHitObject->Intersect( rayRTC,
-                                                                                               hitInfoRTC );
+                        if( hittedC )
+                            hitted = centerHitInfo.pAccObject->Intersect( rayRTC, hitInfoRTC );
+                        else
+                            if( hitPacket[ iRT ].m_hitresult )
+                                hitted = hitPacket[ iRT ].m_HitInfo.pAccObject->Intersect( rayRTC,
+                                                                                           hitInfoRTC );
 
-                            if( hitted )
-                                cRTC = CCOLORRGB( shadeHit( bgColorY, rayRTC, hitInfoRTC, false, 0, false ) );
-                        }
+                        if( hitted )
+                            cRTC = CCOLORRGB( shadeHit( bgColorY, rayRTC, hitInfoRTC, false, 0, false ) );
+                    }
 
 
-                        // Trace and shade cLBC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cLBC = BlendColor( cLB , cC );
+                    // Trace and shade cLBC
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cLBC = BlendColor( cLB , cC );
 
-                        if( hitPacket[ iLB ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayLBC;
-                            rayLBC.Init( ( oriLB + oriC ) * 0.5f,
-                                         glm::normalize( ( dirLB + dirC ) * 0.5f ) );
+                    if( hitPacket[ iLB ].m_hitresult || hittedC )
+                    {
+                        // Trace the center ray
+                        RAY rayLBC;
+                        rayLBC.Init( ( oriLB + oriC ) * 0.5f,
+                                     glm::normalize( ( dirLB + dirC ) * 0.5f ) );
 
-                            HITINFO hitInfoLBC;
-                            hitInfoLBC.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoLBC;
+                        hitInfoLBC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            bool hitted = false;
+                        bool hitted = false;
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLBC, hitInfoLBC );
-                            else
-                                if( hitPacket[ iLB ].m_hitresult )
-                                    hitted = hitPacket[ iLB ].m_HitInfo.pHitObject->Intersect( rayLBC,
-                                                                                               hitInfoLBC );
+                        if( hittedC )
+                            hitted = centerHitInfo.pAccObject->Intersect( rayLBC, hitInfoLBC );
+                        else
+                            if( hitPacket[ iLB ].m_hitresult )
+                                hitted = hitPacket[ iLB ].m_HitInfo.pAccObject->Intersect( rayLBC,
+                                                                                           hitInfoLBC );
 
-                            if( hitted )
-                                cLBC = CCOLORRGB( shadeHit( bgColorY, rayLBC, hitInfoLBC, false, 0, false ) );
-                        }
+                        if( hitted )
+                            cLBC = CCOLORRGB( shadeHit( bgColorY, rayLBC, hitInfoLBC, false, 0, false ) );
+                    }
 
 
-                        // Trace and shade cRBC
-                        // /////////////////////////////////////////////////////////////
-                        CCOLORRGB cRBC = BlendColor( cRB , cC );
+                    // Trace and shade cRBC
+                    // /////////////////////////////////////////////////////////////
+                    CCOLORRGB cRBC = BlendColor( cRB , cC );
 
-                        if( hitPacket[ iRB ].m_hitresult || hittedC )
-                        {
-                            // Trace the center ray
-                            RAY rayRBC;
-                            rayRBC.Init( ( oriRB + oriC ) * 0.5f,
-                                         glm::normalize( ( dirRB + dirC ) * 0.5f ) );
+                    if( hitPacket[ iRB ].m_hitresult || hittedC )
+                    {
+                        // Trace the center ray
+                        RAY rayRBC;
+                        rayRBC.Init( ( oriRB + oriC ) * 0.5f,
+                                     glm::normalize( ( dirRB + dirC ) * 0.5f ) );
 
-                            HITINFO hitInfoRBC;
-                            hitInfoRBC.m_tHit = std::numeric_limits<float>::infinity();
+                        HITINFO hitInfoRBC;
+                        hitInfoRBC.m_tHit = std::numeric_limits<float>::infinity();
 
-                            bool hitted = false;
+                        bool hitted = false;
 
-                            if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRBC, hitInfoRBC );
-                            else
-                                if( hitPacket[ iRB ].m_hitresult )
-                                    hitted = hitPacket[ iRB ].m_HitInfo.pHitObject->Intersect( rayRBC,
-                                                                                               hitInfoRBC );
+                        if( hittedC )
+                            hitted = centerHitInfo.pAccObject->Intersect( rayRBC, hitInfoRBC );
+                        else
+                            if( hitPacket[ iRB ].m_hitresult )
+                                hitted = hitPacket[ iRB ].m_HitInfo.pAccObject->Intersect( rayRBC,
+                                                                                           hitInfoRBC );
 
-                            if( hitted )
-                                cRBC = CCOLORRGB( shadeHit( bgColorY, rayRBC, hitInfoRBC, false, 0, false ) );
-                        }
+                        if( hitted )
+                            cRBC = CCOLORRGB( shadeHit( bgColorY, rayRBC, hitInfoRBC, false, 0, false ) );
+                    }
 
 
-                        // Set pixel colors
-                        // /////////////////////////////////////////////////////////////
-
-                        GLubyte *ptr = &ptrPBO[ (4 * x + m_blockPositionsFast[iBlock].x +
-                                                 m_realBufferSize.x *
-                                                 (m_blockPositionsFast[iBlock].y + 4 * y)) * 4 ];
-                        SetPixel( ptr +  0, cLT );
-                        SetPixel( ptr +  4, BlendColor( cLT, cLRT, cLTC ) );
-                        SetPixel( ptr +  8, cLRT );
-                        SetPixel( ptr + 12, BlendColor( cLRT, cRT, cRTC ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, BlendColor( cLT , cLTB, cLTC ) );
-                        SetPixel( ptr +  4, BlendColor( cLTC, BlendColor( cLT , cC ) ) );
-                        SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRT, cLTC, cRTC ) ) );
-                        SetPixel( ptr + 12, BlendColor( cRTC, BlendColor( cRT , cC ) ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, cLTB );
-                        SetPixel( ptr +  4, BlendColor( cC, BlendColor( cLTB, cLTC, cLBC ) ) );
-                        SetPixel( ptr +  8, cC );
-                        SetPixel( ptr + 12, BlendColor( cC, BlendColor( cRTB, cRTC, cRBC ) ) );
-
-                        ptr += m_realBufferSize.x * 4;
-                        SetPixel( ptr +  0, BlendColor( cLB , cLTB, cLBC ) );
-                        SetPixel( ptr +  4, BlendColor( cLBC, BlendColor( cLB , cC ) ) );
-                        SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRB, cLBC, cRBC ) ) );
-                        SetPixel( ptr + 12, BlendColor( cRBC, BlendColor( cRB , cC ) ) );
-                    }
+                    // Set pixel colors
+                    // /////////////////////////////////////////////////////////////
+
+                    GLubyte *ptr = &ptrPBO[ (4 * x + m_blockPositionsFast[iBlock].x +
+                                             m_realBufferSize.x *
+                                             (m_blockPositionsFast[iBlock].y + 4 * y)) * 4 ];
+                    SetPixel( ptr +  0, cLT );
+                    SetPixel( ptr +  4, BlendColor( cLT, cLRT, cLTC ) );
+                    SetPixel( ptr +  8, cLRT );
+                    SetPixel( ptr + 12, BlendColor( cLRT, cRT, cRTC ) );
+
+                    ptr += m_realBufferSize.x * 4;
+                    SetPixel( ptr +  0, BlendColor( cLT , cLTB, cLTC ) );
+                    SetPixel( ptr +  4, BlendColor( cLTC, BlendColor( cLT , cC ) ) );
+                    SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRT, cLTC, cRTC ) ) );
+                    SetPixel( ptr + 12, BlendColor( cRTC, BlendColor( cRT , cC ) ) );
+
+                    ptr += m_realBufferSize.x * 4;
+                    SetPixel( ptr +  0, cLTB );
+                    SetPixel( ptr +  4, BlendColor( cC, BlendColor( cLTB, cLTC, cLBC ) ) );
+                    SetPixel( ptr +  8, cC );
+                    SetPixel( ptr + 12, BlendColor( cC, BlendColor( cRTB, cRTC, cRBC ) ) );
+
+                    ptr += m_realBufferSize.x * 4;
+                    SetPixel( ptr +  0, BlendColor( cLB , cLTB, cLBC ) );
+                    SetPixel( ptr +  4, BlendColor( cLBC, BlendColor( cLB , cC ) ) );
+                    SetPixel( ptr +  8, BlendColor( cC, BlendColor( cLRB, cLBC, cRBC ) ) );
+                    SetPixel( ptr + 12, BlendColor( cRBC, BlendColor( cRB , cC ) ) );
                 }
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
-    }
-
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+    } );
 }
 
 
@@ -2026,12 +2087,6 @@ SFVEC3F C3D_RENDER_RAYTRACING::shadeHit( const SFVEC3F &aBgColor,
 }
 
 
-void C3D_RENDER_RAYTRACING::initializeNewWindowSize()
-{
-    opengl_init_pbo();
-}
-
-
 void C3D_RENDER_RAYTRACING::opengl_init_pbo()
 {
     if( GLEW_ARB_pixel_buffer_object )
@@ -2147,6 +2202,4 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    opengl_init_pbo();
 }
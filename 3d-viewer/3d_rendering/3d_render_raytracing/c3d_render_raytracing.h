@@ -36,10 +36,12 @@
 #include "../c3d_render_base.h"
 #include "clight.h"
 #include "../cpostshader_ssao.h"
+#include "../cworker_pool.h"
 #include "cmaterial.h"
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <tuple>
 
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -47,6 +49,25 @@ typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a S3DMODEL pointer with a created CBLINN_PHONG_MATERIAL vector
 typedef std::map< const S3DMODEL * , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+/// Triangles of a 3D model, in model coordinates, and the accelerator built on them.
+/// They are shared by all the footprints that place the model.
+struct MODEL_GEOMETRY
+{
+    MODEL_GEOMETRY() : m_accelerator( NULL ) {}
+    MODEL_GEOMETRY( const MODEL_GEOMETRY& ) = delete;
+    MODEL_GEOMETRY& operator=( const MODEL_GEOMETRY& ) = delete;
+    ~MODEL_GEOMETRY() { delete m_accelerator; }
+
+    CCONTAINER           m_triangles;
+    CGENERICACCELERATOR *m_accelerator;
+};
+
+/// The S3DMODEL pointer, the model opacity and if it is placed mirrored
+typedef std::tuple< const S3DMODEL *, float, bool > MODEL_GEOMETRY_KEY;
+
+/// Maps a placed 3D model with its shared geometry
+typedef std::map< MODEL_GEOMETRY_KEY, MODEL_GEOMETRY > MAP_MODEL_GEOMETRY;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -70,9 +91,30 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * Render the full quality image (including post processing) into a memory buffer.
+     *
+     * Unlike Redraw(), this makes no OpenGL call and does not need a current OpenGL context,
+     * so it can create images of the board without a 3D canvas.  Do not call
+     * SetCurWindowSize() for such a render, it sets the OpenGL viewport.  The point of view
+     * is the camera given to the renderer, its window size must be set to aSize.
+     * @param aSize is the requested image size, the rendered image is a few pixels smaller
+     *              to fit the ray packets (see GetRealBufferSize()).
+     * @param aBuffer will receive GetRealBufferSize().x * GetRealBufferSize().y RGBA pixels,
+     *                the bottom row first (OpenGL convention).
+     * @param aStatusTextReporter is an optional reporter for the render progress.
+     */
+    void RenderToBuffer( const wxSize& aSize, std::vector<GLubyte>& aBuffer,
+                         REPORTER* aStatusTextReporter = nullptr );
+
+    /**
+     * @return the size of the rendered image, which is the window size rounded to the
+     * ray packet size.
+     */
+    const SFVEC2UI& GetRealBufferSize() const { return m_realBufferSize; }
+
 private:
     bool initializeOpenGL();
-    void initializeNewWindowSize();
     void opengl_init_pbo();
     void opengl_delete_pbo();
     void reload( REPORTER* aStatusTextReporter, REPORTER* aWarningTextReporter );
@@ -136,6 +178,9 @@ private:
 
     CPOSTSHADER_SSAO m_postshader_ssao;
 
+    /// Threads running the render passes, kept alive from one pass to the next
+    CWORKER_POOL m_workers;
+
     CLIGHTCONTAINER m_lights;
 
     CDIRECTIONALLIGHT *m_camera_light;
@@ -199,10 +244,19 @@ private:
     void add_3D_models( const S3DMODEL *a3DModel,
                         const glm::mat4 &aModelMatrix,
                         float aModuleOpacity );
+    void add_3D_model_triangles( CCONTAINER &aDstContainer,
+                                 const S3DMODEL *a3DModel,
+                                 const MODEL_MATERIALS &aMaterials,
+                                 float aScale,
+                                 float aModuleOpacity,
+                                 bool aIsMirrored );
 
     /// Stores materials of the 3D models
     MAP_MODEL_MATERIALS m_model_materials;
 
+    /// Stores the geometry of the 3D models, instanced by the footprints
+    MAP_MODEL_GEOMETRY m_model_geometry;
+
     void initialize_block_positions();
 
     void render( GLubyte *ptrPBO, REPORTER *aStatusTextReporter );
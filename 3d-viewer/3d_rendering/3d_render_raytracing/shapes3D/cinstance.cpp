@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cinstance.cpp
+ * @brief
+ */
+
+#include "cinstance.h"
+#include <wx/debug.h>
+
+
+CINSTANCE::CINSTANCE( const CGENERICACCELERATOR *aAccelerator, const CBBOX &aLocalBBox,
+                      const glm::mat4 &aLocalToWorld ) :
+        COBJECT( OBJECT3D_TYPE::INSTANCE )
+{
+    wxASSERT( aAccelerator != NULL );
+
+    m_accelerator  = aAccelerator;
+    m_worldToLocal = glm::inverse( aLocalToWorld );
+    m_normalMatrix = glm::transpose( glm::inverse( glm::mat3( aLocalToWorld ) ) );
+
+    // The world bounding box is the one that contains the transformed corners
+    // of the local bounding box
+    const SFVEC3F &min = aLocalBBox.Min();
+    const SFVEC3F &max = aLocalBBox.Max();
+
+    m_bbox.Reset();
+
+    for( unsigned int i = 0; i < 8; ++i )
+    {
+        const SFVEC3F corner( ( i & 1 ) ? max.x : min.x,
+                              ( i & 2 ) ? max.y : min.y,
+                              ( i & 4 ) ? max.z : min.z );
+
+        m_bbox.Union( SFVEC3F( aLocalToWorld * glm::vec4( corner, 1.0f ) ) );
+    }
+
+    m_bbox.ScaleNextUp();
+    m_centroid = m_bbox.GetCenter();
+}
+
+
+void CINSTANCE::toLocal( const RAY &aRay, RAY &aLocalRay ) const
+{
+    // The direction is not normalized, so the distance along the local ray is
+    // the same as the distance along the world ray
+    aLocalRay.Init( SFVEC3F( m_worldToLocal * glm::vec4( aRay.m_Origin, 1.0f ) ),
+                    SFVEC3F( m_worldToLocal * glm::vec4( aRay.m_Dir, 0.0f ) ) );
+}
+
+
+bool CINSTANCE::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
+{
+    RAY localRay;
+
+    toLocal( aRay, localRay );
+
+    if( !m_accelerator->Intersect( localRay, aHitInfo ) )
+        return false;
+
+    aHitInfo.m_HitPoint  = aRay.at( aHitInfo.m_tHit );
+    aHitInfo.m_HitNormal = glm::normalize( m_normalMatrix * aHitInfo.m_HitNormal );
+
+    return true;
+}
+
+
+bool CINSTANCE::IntersectP( const RAY &aRay, float aMaxDistance ) const
+{
+    RAY localRay;
+
+    toLocal( aRay, localRay );
+
+    return m_accelerator->IntersectP( localRay, aMaxDistance );
+}
+
+
+bool CINSTANCE::Intersects( const CBBOX &aBBox ) const
+{
+    //!TODO: improove
+    return m_bbox.Intersects( aBBox );
+}
+
+
+SFVEC3F CINSTANCE::GetDiffuseColor( const HITINFO &aHitInfo ) const
+{
+    // An instance never reports itself as the hit object, the color is the one of
+    // the shared object that was hit
+    wxASSERT( aHitInfo.pHitObject != this );
+
+    return aHitInfo.pHitObject->GetDiffuseColor( aHitInfo );
+}
@@ -0,0 +1,72 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cinstance.h
+ * @brief
+ */
+
+#ifndef _CINSTANCE_H_
+#define _CINSTANCE_H_
+
+#include "cobject.h"
+#include "../accelerators/caccelerator.h"
+
+/**
+ * A placed copy of a shared group of objects (e.g. the triangles of a 3D model).
+ * The objects are stored once, in their own accelerator and local coordinates, and
+ * every instance only keeps the transformation to world coordinates. Rays are
+ * transformed to the local space when they hit the instance bounding box.
+ *
+ * The hit information returned refers to the shared object that was hit, with the
+ * hit point and normal converted back to world coordinates.
+ */
+class  CINSTANCE : public COBJECT
+{
+
+public:
+    /**
+     * @param aAccelerator - the accelerator of the shared objects, it is not owned
+     * @param aLocalBBox - bounding box of the shared objects, in local coordinates
+     * @param aLocalToWorld - transformation from local to world coordinates
+     */
+    CINSTANCE( const CGENERICACCELERATOR *aAccelerator, const CBBOX &aLocalBBox,
+               const glm::mat4 &aLocalToWorld );
+
+    // Imported from COBJECT
+    bool Intersect( const RAY &aRay, HITINFO &aHitInfo ) const override;
+    bool IntersectP( const RAY &aRay, float aMaxDistance ) const override;
+    bool Intersects( const CBBOX &aBBox ) const override;
+    SFVEC3F GetDiffuseColor( const HITINFO &aHitInfo ) const override;
+
+private:
+    void toLocal( const RAY &aRay, RAY &aLocalRay ) const;
+
+private:
+    const CGENERICACCELERATOR *m_accelerator;
+    glm::mat4 m_worldToLocal;
+    glm::mat3 m_normalMatrix;
+};
+
+
+#endif // _CINSTANCE_H_
@@ -56,7 +56,8 @@ const std::map<OBJECT3D_TYPE, const char*> objectTypeNames
     { OBJECT3D_TYPE::LAYERITEM,  "OBJECT2D_TYPE::LAYERITEM" },
     { OBJECT3D_TYPE::XYPLANE,    "OBJECT2D_TYPE::XYPLANE" },
     { OBJECT3D_TYPE::ROUNDSEG,   "OBJECT2D_TYPE::ROUNDSEG" },
-    { OBJECT3D_TYPE::TRIANGLE,   "OBJECT2D_TYPE::TRIANGLE" }
+    { OBJECT3D_TYPE::TRIANGLE,   "OBJECT2D_TYPE::TRIANGLE" },
+    { OBJECT3D_TYPE::INSTANCE,   "OBJECT3D_TYPE::INSTANCE" }
 };
 // clang-format on
 
@@ -43,6 +43,7 @@ enum class OBJECT3D_TYPE
     XYPLANE,
     ROUNDSEG,
     TRIANGLE,
+    INSTANCE,
     MAX
 };
 
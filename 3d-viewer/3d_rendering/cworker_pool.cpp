@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file cworker_pool.cpp
+ */
+
+#include "cworker_pool.h"
+
+
+CWORKER_POOL::CWORKER_POOL( size_t aThreadCount ) :
+        m_job( nullptr ),
+        m_jobId( 0 ),
+        m_running( 0 ),
+        m_quit( false )
+{
+    m_threads.reserve( aThreadCount );
+
+    for( size_t ii = 0; ii < aThreadCount; ++ii )
+        m_threads.emplace_back( &CWORKER_POOL::workerLoop, this );
+}
+
+
+CWORKER_POOL::~CWORKER_POOL()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_quit = true;
+    }
+
+    m_jobReady.notify_all();
+
+    for( std::thread& thread : m_threads )
+        thread.join();
+}
+
+
+void CWORKER_POOL::Run( const std::function<void()>& aJob )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    m_job = &aJob;
+    m_running = m_threads.size();
+    m_jobId++;
+
+    m_jobReady.notify_all();
+    m_jobDone.wait( lock, [&]() { return m_running == 0; } );
+
+    m_job = nullptr;
+}
+
+
+void CWORKER_POOL::workerLoop()
+{
+    unsigned int lastJobId = 0;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    while( true )
+    {
+        m_jobReady.wait( lock, [&]() { return m_quit || m_jobId != lastJobId; } );
+
+        if( m_quit )
+            return;
+
+        lastJobId = m_jobId;
+        const std::function<void()>* job = m_job;
+
+        lock.unlock();
+        ( *job )();
+        lock.lock();
+
+        if( --m_running == 0 )
+            m_jobDone.notify_one();
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file cworker_pool.h
+ * @brief a set of threads kept alive between the passes of a render
+ */
+
+#ifndef CWORKER_POOL_H
+#define CWORKER_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Threads started once and reused by every render pass, so a progressive render does not
+ * pay for creating and joining threads several times per frame.
+ *
+ * The jobs given to Run() share their work through their own atomic counters, the pool only
+ * starts them on all the workers and waits until they return.
+ */
+class CWORKER_POOL
+{
+public:
+    explicit CWORKER_POOL( size_t aThreadCount );
+    ~CWORKER_POOL();
+
+    CWORKER_POOL( const CWORKER_POOL& ) = delete;
+    CWORKER_POOL& operator=( const CWORKER_POOL& ) = delete;
+
+    size_t GetThreadCount() const { return m_threads.size(); }
+
+    /**
+     * Run aJob on every worker thread and wait until all of them returned.
+     */
+    void Run( const std::function<void()>& aJob );
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread>     m_threads;
+    std::mutex                   m_mutex;
+    std::condition_variable      m_jobReady;
+    std::condition_variable      m_jobDone;
+
+    const std::function<void()>* m_job;
+    unsigned int                 m_jobId;       ///< incremented for every new job
+    size_t                       m_running;     ///< workers still running the current job
+    bool                         m_quit;
+};
+
+
+#endif // CWORKER_POOL_H
@@ -80,6 +80,13 @@ static const wxChar RealtimeConnectivity[] = wxT( "RealtimeConnectivity" );
  */
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 
+/**
+ * Items on cached layers whose bounding box is smaller than this many pixels on screen
+ * are drawn as a one pixel dot instead of their full geometry, which speeds up redraws of
+ * dense boards when zoomed out.  Set it to 0 to always draw the full items.
+ */
+static const wxChar MinItemScreenSize[] = wxT( "MinItemScreenSize" );
+
 } // namespace KEYS
 
 
@@ -160,6 +167,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_EnableUsePadProperty = false;
     m_realTimeConnectivity = true;
     m_coroutineStackSize = AC_STACK::default_stack;
+    m_minItemScreenSize = 1.0;
 
     loadFromConfigFile();
 }
@@ -203,6 +211,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                &m_coroutineStackSize, AC_STACK::default_stack,
                                                AC_STACK::min_stack, AC_STACK::max_stack ) );
 
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::MinItemScreenSize,
+                                                  &m_minItemScreenSize, 1.0, 0.0, 10.0 ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     for( auto param : configParams )
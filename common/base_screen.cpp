@@ -48,6 +48,7 @@ BASE_SCREEN::BASE_SCREEN( KICAD_T aType ) :
     EDA_ITEM( aType )
 {
     m_UndoRedoCountMax = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMax = DEFAULT_MAX_UNDO_MEMORY;
     m_Initialized      = false;
     m_ScreenNumber     = 1;
     m_NumberOfScreens  = 1;      // Hierarchy: Root: ScreenNumber = 1
@@ -297,6 +298,8 @@ void BASE_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
         if( extraitems > 0 )
             ClearUndoORRedoList( m_UndoList, extraitems );
     }
+
+    trimUndoORRedoList( m_UndoList );
 }
 
 
@@ -312,6 +315,38 @@ void BASE_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
         if( extraitems > 0 )
             ClearUndoORRedoList( m_RedoList, extraitems );
     }
+
+    trimUndoORRedoList( m_RedoList );
+}
+
+
+void BASE_SCREEN::trimUndoORRedoList( UNDO_REDO_CONTAINER& aList )
+{
+    if( m_UndoRedoMemoryMax <= 0 )
+        return;
+
+    const size_t budget = (size_t) m_UndoRedoMemoryMax * 1024 * 1024;
+    size_t       usage = 0;
+    int          keptitems = 0;
+
+    // Walk from the most recent command, and delete all the commands older than the
+    // first one exceeding the budget.  The most recent command is always kept.
+    // The usage is estimated again at each push: the data a command shares with the board
+    // becomes its own when the board item changes (e.g. when a zone is refilled).
+    for( auto it = aList.m_CommandsList.rbegin(); it != aList.m_CommandsList.rend(); ++it )
+    {
+        usage += GetCommandMemoryUsage( **it );
+
+        if( keptitems > 0 && usage > budget )
+            break;
+
+        keptitems++;
+    }
+
+    int extraitems = (int) aList.m_CommandsList.size() - keptitems;
+
+    if( extraitems > 0 )
+        ClearUndoORRedoList( aList, extraitems );
 }
 
 
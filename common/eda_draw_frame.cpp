@@ -75,6 +75,7 @@ EDA_DRAW_FRAME::EDA_DRAW_FRAME( KIWAY* aKiway, wxWindow* aParent, FRAME_T aFrame
     m_zoomSelectBox       = NULL;
     m_firstRunDialogSetting = 0;
     m_UndoRedoCountMax    = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMax   = DEFAULT_MAX_UNDO_MEMORY;
 
     m_canvasType          = EDA_DRAW_PANEL_GAL::GAL_TYPE_NONE;
     m_canvas              = NULL;
@@ -480,6 +481,7 @@ void EDA_DRAW_FRAME::LoadSettings( APP_SETTINGS_BASE* aCfg )
         m_LastGridSizeId = 0;
 
     m_UndoRedoCountMax = aCfg->m_System.max_undo_items;
+    m_UndoRedoMemoryMax = aCfg->m_System.max_undo_memory;
     m_firstRunDialogSetting = aCfg->m_System.first_run_shown;
 
     m_galDisplayOptions.ReadConfig( *cmnCfg, *window, this );
@@ -509,7 +511,10 @@ void EDA_DRAW_FRAME::SaveSettings( APP_SETTINGS_BASE* aCfg )
     window->grid.last_size = m_LastGridSizeId;
 
     if( GetScreen() )
+    {
         aCfg->m_System.max_undo_items = GetScreen()->GetMaxUndoItems();
+        aCfg->m_System.max_undo_memory = GetScreen()->GetMaxUndoMemory();
+    }
 
     m_galDisplayOptions.WriteConfig( *window );
 
@@ -780,8 +780,9 @@ void CAIRO_GAL_BASE::DrawGroup( int aGroupNumber )
 
     storePath();
 
-    for( GROUP::iterator it = groups[aGroupNumber].begin();
-         it != groups[aGroupNumber].end(); ++it )
+    GROUP& group = groups[aGroupNumber];
+
+    for( GROUP::iterator it = group.begin(); it != group.end(); ++it )
     {
         switch( it->command )
         {
@@ -867,8 +868,9 @@ void CAIRO_GAL_BASE::ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColo
 {
     storePath();
 
-    for( GROUP::iterator it = groups[aGroupNumber].begin();
-         it != groups[aGroupNumber].end(); ++it )
+    GROUP& group = groups[aGroupNumber];
+
+    for( GROUP::iterator it = group.begin(); it != group.end(); ++it )
     {
         if( it->command == CMD_SET_FILLCOLOR || it->command == CMD_SET_STROKECOLOR )
         {
@@ -1448,7 +1450,7 @@ void CAIRO_GAL::allocateBitmaps()
     stride     = cairo_format_stride_for_width( GAL_FORMAT, wxBufferWidth );
     bufferSize = stride * screenSize.y;
 
-    bitmapBuffer        = new unsigned char[bufferSize * 4];
+    bitmapBuffer        = new unsigned char[bufferSize];
     wxOutput            = new unsigned char[wxBufferWidth * 3 * screenSize.y];
 }
 
@@ -40,6 +40,7 @@ const double STROKE_FONT::OVERBAR_POSITION_FACTOR = 1.40;
 const double STROKE_FONT::BOLD_FACTOR = 1.3;
 const double STROKE_FONT::STROKE_FONT_SCALE = 1.0 / 21.0;
 const double STROKE_FONT::ITALIC_TILT = 1.0 / 8;
+const size_t STROKE_FONT::LINE_CACHE_SIZE = 2048;
 
 
 GLYPH_LIST*         g_newStrokeFontGlyphs = nullptr;     ///< Glyph list
@@ -62,35 +63,47 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
     }
 
     g_newStrokeFontGlyphs = new GLYPH_LIST;
-    g_newStrokeFontGlyphs->reserve( aNewStrokeFontSize );
-
     g_newStrokeFontGlyphBoundingBoxes = new std::vector<BOX2D>;
-    g_newStrokeFontGlyphBoundingBoxes->reserve( aNewStrokeFontSize );
+
+    // Size the tables before decoding, so the whole font lives in a few allocations
+    // instead of one per stroke.  Every coordinate pair after the glyph width is either
+    // a point or a pen up (" R").
+    size_t pointCount = 0;
+    size_t strokeCount = 0;
 
     for( int j = 0; j < aNewStrokeFontSize; j++ )
     {
-        GLYPH*   glyph = new GLYPH;
-        double   glyphStartX = 0.0;
-        double   glyphEndX = 0.0;
-        double   glyphWidth = 0.0;
-
-        std::vector<VECTOR2D>* pointList = nullptr;
-
-        int strokes = 0;
-        int i = 0;
-
-        while( aNewStrokeFont[j][i] )
+        for( int i = 2; aNewStrokeFont[j][i]; i += 2 )
         {
-
             if( aNewStrokeFont[j][i] == ' ' && aNewStrokeFont[j][i+1] == 'R' )
-                strokes++;
-
-            i += 2;
+                strokeCount++;
+            else
+                pointCount++;
         }
 
-        glyph->reserve( strokes + 1 );
+        strokeCount++;
+    }
+
+    std::vector<VECTOR2D>&     points  = g_newStrokeFontGlyphs->m_points;
+    std::vector<GLYPH_STROKE>& strokes = g_newStrokeFontGlyphs->m_strokes;
+    std::vector<GLYPH>&        glyphs  = g_newStrokeFontGlyphs->m_glyphs;
 
-        i = 0;
+    points.reserve( pointCount );
+    strokes.reserve( strokeCount );
+    glyphs.reserve( aNewStrokeFontSize );
+    g_newStrokeFontGlyphBoundingBoxes->reserve( aNewStrokeFontSize );
+
+    // computeBoundingBox() reads the decoded strokes through m_glyphs
+    m_glyphs = g_newStrokeFontGlyphs;
+
+    for( int j = 0; j < aNewStrokeFontSize; j++ )
+    {
+        GLYPH    glyph = { (unsigned int) strokes.size(), 0 };
+        double   glyphStartX = 0.0;
+        double   glyphEndX = 0.0;
+        double   glyphWidth = 0.0;
+        bool     penDown = false;
+        int      i = 0;
 
         while( aNewStrokeFont[j][i] )
         {
@@ -109,11 +122,8 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
             }
             else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
             {
-                if( pointList )
-                    pointList->shrink_to_fit();
-
                 // Raise pen
-                pointList = nullptr;
+                penDown = false;
             }
             else
             {
@@ -132,27 +142,26 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 // Only shapes like j y have coordinates < 0
                 point.y = (double) ( coordinate[1] - 'R' + FONT_OFFSET ) * STROKE_FONT_SCALE;
 
-                if( !pointList )
+                if( !penDown )
                 {
-                    pointList = new std::vector<VECTOR2D>;
-                    glyph->push_back( pointList );
+                    strokes.push_back( { (unsigned int) points.size(), 0 } );
+                    glyph.m_strokeCount++;
+                    penDown = true;
                 }
 
-                pointList->push_back( point );
+                points.push_back( point );
+                strokes.back().m_pointCount++;
             }
 
             i += 2;
         }
 
-        if( pointList )
-            pointList->shrink_to_fit();
+        glyphs.push_back( glyph );
 
         // Compute the bounding box of the glyph
         g_newStrokeFontGlyphBoundingBoxes->emplace_back( computeBoundingBox( glyph, glyphWidth ) );
-        g_newStrokeFontGlyphs->push_back( glyph );
     }
 
-    m_glyphs = g_newStrokeFontGlyphs;
     m_glyphBoundingBoxes = g_newStrokeFontGlyphBoundingBoxes;
     return true;
 }
@@ -167,15 +176,19 @@ double STROKE_FONT::GetInterline( double aGlyphHeight )
 }
 
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH* aGLYPH, double aGlyphWidth ) const
+BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGlyph, double aGlyphWidth ) const
 {
     VECTOR2D min( 0, 0 );
     VECTOR2D max( aGlyphWidth, 0 );
 
-    for( const std::vector<VECTOR2D>* pointList : *aGLYPH )
+    for( unsigned int s = 0; s < aGlyph.m_strokeCount; ++s )
     {
-        for( const VECTOR2D& point : *pointList )
+        const GLYPH_STROKE& stroke = m_glyphs->m_strokes[aGlyph.m_firstStroke + s];
+
+        for( unsigned int p = 0; p < stroke.m_pointCount; ++p )
         {
+            const VECTOR2D& point = m_glyphs->m_points[stroke.m_firstPoint + p];
+
             min.y = std::min( min.y, point.y );
             max.y = std::max( max.y, point.y );
         }
@@ -265,19 +278,64 @@ void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRo
 }
 
 
-void STROKE_FONT::drawSingleLineText( const UTF8& aText )
+bool STROKE_FONT::LINE_CACHE_KEY::operator<( const LINE_CACHE_KEY& aOther ) const
 {
-    double      xOffset;
-    double      yOffset;
-    VECTOR2D    baseGlyphSize( m_gal->GetGlyphSize() );
-    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+    if( m_glyphSize.x != aOther.m_glyphSize.x )
+        return m_glyphSize.x < aOther.m_glyphSize.x;
 
-    if( m_gal->IsTextMirrored() )
-        overbar_italic_comp = -overbar_italic_comp;
+    if( m_glyphSize.y != aOther.m_glyphSize.y )
+        return m_glyphSize.y < aOther.m_glyphSize.y;
+
+    if( m_lineWidth != aOther.m_lineWidth )
+        return m_lineWidth < aOther.m_lineWidth;
+
+    if( m_italic != aOther.m_italic )
+        return m_italic < aOther.m_italic;
+
+    if( m_mirrored != aOther.m_mirrored )
+        return m_mirrored < aOther.m_mirrored;
+
+    return m_text < aOther.m_text;
+}
 
-    // Compute the text size
-    VECTOR2D textSize = computeTextLineSize( aText );
-    double half_thickness = m_gal->GetLineWidth()/2;
+
+const STROKE_FONT::LINE_CACHE_ENTRY& STROKE_FONT::getLineGeometry( const UTF8& aText )
+{
+    LINE_CACHE_KEY key = { aText, m_gal->GetGlyphSize(), m_gal->GetLineWidth(),
+                           m_gal->IsFontItalic(), m_gal->IsTextMirrored() };
+
+    auto it = m_lineCache.find( key );
+
+    if( it != m_lineCache.end() )
+    {
+        // Move the line to the front of the LRU list
+        m_lineCacheLru.splice( m_lineCacheLru.begin(), m_lineCacheLru, it->second.m_lruPosition );
+        return it->second;
+    }
+
+    if( m_lineCache.size() >= LINE_CACHE_SIZE )
+    {
+        m_lineCache.erase( *m_lineCacheLru.back() );
+        m_lineCacheLru.pop_back();
+    }
+
+    it = m_lineCache.emplace( std::move( key ), LINE_CACHE_ENTRY() ).first;
+
+    LINE_CACHE_ENTRY& entry = it->second;
+
+    computeLineGeometry( aText, entry );
+    m_lineCacheLru.push_front( &it->first );
+    entry.m_lruPosition = m_lineCacheLru.begin();
+
+    return entry;
+}
+
+
+void STROKE_FONT::drawSingleLineText( const UTF8& aText )
+{
+    const LINE_CACHE_ENTRY& line = getLineGeometry( aText );
+    const VECTOR2D&         textSize = line.m_textSize;
+    double                  half_thickness = m_gal->GetLineWidth()/2;
 
     // Context needs to be saved before any transformations
     m_gal->Save();
@@ -310,6 +368,31 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         break;
     }
 
+    for( size_t i = 0; i + 1 < line.m_overbars.size(); i += 2 )
+        m_gal->DrawLine( line.m_overbars[i], line.m_overbars[i + 1] );
+
+    for( const std::deque<VECTOR2D>& polyline : line.m_polylines )
+        m_gal->DrawPolyline( polyline );
+
+    m_gal->Restore();
+}
+
+
+void STROKE_FONT::computeLineGeometry( const UTF8& aText, LINE_CACHE_ENTRY& aEntry ) const
+{
+    double      xOffset;
+    double      yOffset;
+    VECTOR2D    baseGlyphSize( m_gal->GetGlyphSize() );
+    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+
+    if( m_gal->IsTextMirrored() )
+        overbar_italic_comp = -overbar_italic_comp;
+
+    // Compute the text size
+    VECTOR2D textSize = computeTextLineSize( aText );
+
+    aEntry.m_textSize = textSize;
+
     if( m_gal->IsTextMirrored() )
     {
         // In case of mirrored text invert the X scale of points and their X direction
@@ -416,7 +499,7 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             dd = substitute - ' ';
         }
 
-        const GLYPH* glyph = m_glyphs->at( dd );
+        const GLYPH& glyph = m_glyphs->m_glyphs.at( dd );
         const BOX2D& bbox  = m_glyphBoundingBoxes->at( dd );
 
         if( in_overbar )
@@ -434,23 +517,26 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 last_had_overbar = true;
             }
 
-            VECTOR2D startOverbar( overbar_start_x, overbar_start_y );
-            VECTOR2D endOverbar( overbar_end_x, overbar_end_y );
-
-            m_gal->DrawLine( startOverbar, endOverbar );
+            aEntry.m_overbars.emplace_back( overbar_start_x, overbar_start_y );
+            aEntry.m_overbars.emplace_back( overbar_end_x, overbar_end_y );
         }
         else
         {
             last_had_overbar = false;
         }
 
-        for( const std::vector<VECTOR2D>* ptList : *glyph )
+        for( unsigned int s = 0; s < glyph.m_strokeCount; ++s )
         {
-            std::deque<VECTOR2D> ptListScaled;
+            const GLYPH_STROKE& stroke = m_glyphs->m_strokes[glyph.m_firstStroke + s];
+
+            aEntry.m_polylines.emplace_back();
+            std::deque<VECTOR2D>& ptListScaled = aEntry.m_polylines.back();
 
-            for( const VECTOR2D& pt : *ptList )
+            for( unsigned int p = 0; p < stroke.m_pointCount; ++p )
             {
-                VECTOR2D scaledPt( pt.x * glyphSize.x + xOffset, pt.y * glyphSize.y + yOffset );
+                const VECTOR2D& pt = m_glyphs->m_points[stroke.m_firstPoint + p];
+                VECTOR2D        scaledPt( pt.x * glyphSize.x + xOffset,
+                                          pt.y * glyphSize.y + yOffset );
 
                 if( m_gal->IsFontItalic() )
                 {
@@ -464,14 +550,10 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 
                 ptListScaled.push_back( scaledPt );
             }
-
-            m_gal->DrawPolyline( ptListScaled );
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
     }
-
-    m_gal->Restore();
 }
 
 
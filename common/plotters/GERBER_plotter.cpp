@@ -302,18 +302,16 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int aWidth, void* aData )
 int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
                         APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
 {
-    int last_D_code = 9;
+    APERTURE_KEY key = { aType, aSize.x, aSize.y, aApertureAttribute };
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+    auto it = m_apertureIndex.find( key );
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return idx;
-    }
+    if( it != m_apertureIndex.end() )
+        return it->second;
+
+    // D codes are allocated sequentially, starting at D10
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -323,6 +321,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
+    m_apertureIndex[key] = m_apertures.size() - 1;
 
     return m_apertures.size() - 1;
 }
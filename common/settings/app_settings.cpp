@@ -89,6 +89,9 @@ APP_SETTINGS_BASE::APP_SETTINGS_BASE( std::string aFilename, int aSchemaVersion
 
     m_params.emplace_back( new PARAM<int>( "system.max_undo_items", &m_System.max_undo_items, 0 ) );
 
+    m_params.emplace_back( new PARAM<int>( "system.max_undo_memory",
+            &m_System.max_undo_memory, 512 ) );
+
 
     m_params.emplace_back( new PARAM_LIST<wxString>( "system.file_history",
             &m_System.file_history, {} ) );
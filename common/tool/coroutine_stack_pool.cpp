@@ -0,0 +1,213 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <tool/coroutine_stack_pool.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+const size_t COROUTINE_STACK_POOL::MAX_FREE_STACKS = 8;
+
+
+COROUTINE_STACK_POOL& COROUTINE_STACK_POOL::Get()
+{
+    static COROUTINE_STACK_POOL pool;
+
+    return pool;
+}
+
+
+COROUTINE_STACK_POOL::COROUTINE_STACK_POOL() :
+        m_mapped( 0 ),
+        m_reused( 0 )
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    m_pageSize = info.dwPageSize;
+#else
+    m_pageSize = sysconf( _SC_PAGESIZE );
+#endif
+}
+
+
+COROUTINE_STACK_POOL::~COROUTINE_STACK_POOL()
+{
+    // Only the released stacks are unmapped, a coroutine could still be using the others
+    for( const STACK& stack : m_freeStacks )
+        unmapStack( stack );
+}
+
+
+COROUTINE_STACK_POOL::STACK COROUTINE_STACK_POOL::mapStack( size_t aSize )
+{
+    size_t size = ( aSize + m_pageSize - 1 ) / m_pageSize * m_pageSize;
+    size_t total = size + m_pageSize;
+    char*  block = nullptr;
+
+#ifdef _WIN32
+    block = (char*) VirtualAlloc( nullptr, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+
+    DWORD oldProtect;
+
+    if( block && !VirtualProtect( block, m_pageSize, PAGE_NOACCESS, &oldProtect ) )
+    {
+        VirtualFree( block, 0, MEM_RELEASE );
+        block = nullptr;
+    }
+#else
+    void* mapped = mmap( nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1, 0 );
+
+    if( mapped != MAP_FAILED )
+    {
+        block = (char*) mapped;
+
+        if( mprotect( block, m_pageSize, PROT_NONE ) != 0 )
+        {
+            munmap( block, total );
+            block = nullptr;
+        }
+    }
+#endif
+
+    if( !block )
+        return STACK{ nullptr, 0 };
+
+    return STACK{ block + m_pageSize, size };
+}
+
+
+void COROUTINE_STACK_POOL::unmapStack( const STACK& aStack )
+{
+    char* block = aStack.m_base - m_pageSize;
+
+#ifdef _WIN32
+    VirtualFree( block, 0, MEM_RELEASE );
+#else
+    munmap( block, aStack.m_size + m_pageSize );
+#endif
+}
+
+
+COROUTINE_STACK_POOL::STACK COROUTINE_STACK_POOL::Acquire( size_t aSize )
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    for( auto it = m_freeStacks.begin(); it != m_freeStacks.end(); ++it )
+    {
+        if( it->m_size >= aSize )
+        {
+            STACK stack = *it;
+
+            m_freeStacks.erase( it );
+            m_reused++;
+
+            return stack;
+        }
+    }
+
+    STACK stack = mapStack( aSize );
+
+    if( stack.m_base )
+    {
+        m_stacks.push_back( stack );
+        m_mapped++;
+    }
+
+    return stack;
+}
+
+
+void COROUTINE_STACK_POOL::Release( const STACK& aStack )
+{
+    if( !aStack.m_base )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( m_freeStacks.size() < MAX_FREE_STACKS )
+    {
+        m_freeStacks.push_back( aStack );
+        return;
+    }
+
+    m_stacks.erase( std::remove_if( m_stacks.begin(), m_stacks.end(),
+                                    [&]( const STACK& aCandidate )
+                                    {
+                                        return aCandidate.m_base == aStack.m_base;
+                                    } ),
+                    m_stacks.end() );
+
+    unmapStack( aStack );
+}
+
+
+size_t COROUTINE_STACK_POOL::GetMappedCount() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    return m_mapped;
+}
+
+
+size_t COROUTINE_STACK_POOL::GetReusedCount() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    return m_reused;
+}
+
+
+size_t COROUTINE_STACK_POOL::GetStackCount() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    return m_stacks.size();
+}
+
+
+size_t COROUTINE_STACK_POOL::GetHighWaterMark() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    size_t highWater = 0;
+
+    for( const STACK& stack : m_stacks )
+    {
+        const char* begin = stack.m_base;
+        const char* end = begin + stack.m_size;
+        const char* p = std::find_if( begin, end, []( char c ) { return c != 0; } );
+
+        highWater = std::max<size_t>( highWater, end - p );
+    }
+
+    return highWater;
+}
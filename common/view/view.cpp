@@ -24,6 +24,9 @@
  */
 
 
+#include <bitset>
+
+#include <advanced_config.h>
 #include <base_struct.h>
 #include <layers_id_colors_and_visibility.h>
 
@@ -99,6 +102,10 @@ private:
     GroupPair* m_groups;
     int        m_groupsSize;
 
+    ///> Offset added to the layer number to store the group id of the simplified representation
+    ///> of the item (see VIEW::drawStandIn()) next to the regular ones.
+    static constexpr int STAND_IN_OFFSET = VIEW::VIEW_MAX_LAYERS + 1;
+
     /**
      * Function getGroup()
      * Returns number of the group id for the given layer, or -1 in case it was not cached before.
@@ -117,6 +124,16 @@ private:
         return -1;
     }
 
+    /**
+     * Function getStandInGroup()
+     * Returns the group id of the simplified representation for the given layer, or -1 in
+     * case it was not cached before.
+     */
+    int getStandInGroup( int aLayer ) const
+    {
+        return getGroup( aLayer + STAND_IN_OFFSET );
+    }
+
     /**
      * Function getAllGroups()
      * Returns all group ids for the item (collected from all layers the item occupies).
@@ -167,6 +184,31 @@ private:
         newGroups[m_groupsSize++] = GroupPair( aLayer, aGroup );
     }
 
+    /**
+     * Function setStandInGroup()
+     * Sets the group id of the simplified representation for the given layer.
+     */
+    void setStandInGroup( int aLayer, int aGroup )
+    {
+        setGroup( aLayer + STAND_IN_OFFSET, aGroup );
+    }
+
+    /**
+     * Function deleteStandInGroup()
+     * Removes the simplified representation cached for the given layer, so it is created
+     * again from the current item geometry the next time it is needed.
+     */
+    void deleteStandInGroup( GAL* aGal, int aLayer )
+    {
+        int group = getStandInGroup( aLayer );
+
+        if( group >= 0 )
+        {
+            aGal->DeleteGroup( group );
+            setStandInGroup( aLayer, -1 );
+        }
+    }
+
 
     /**
      * Function deleteGroups()
@@ -202,7 +244,8 @@ private:
     {
         for( int i = 0; i < m_groupsSize; ++i )
         {
-            int orig_layer = m_groups[i].first;
+            int offset = m_groups[i].first >= STAND_IN_OFFSET ? STAND_IN_OFFSET : 0;
+            int orig_layer = m_groups[i].first - offset;
             int new_layer = orig_layer;
 
             try
@@ -211,7 +254,7 @@ private:
             }
             catch( const std::out_of_range& ) {}
 
-            m_groups[i].first = new_layer;
+            m_groups[i].first = new_layer + offset;
         }
     }
 
@@ -293,7 +336,8 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_minItemScreenSize( ADVANCED_CFG::GetCfg().m_minItemScreenSize )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -406,6 +450,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
 
         if( prevGroup >= 0 )
             m_gal->DeleteGroup( prevGroup );
+
+        viewData->deleteStandInGroup( m_gal, layers[i] );
     }
 
     viewData->deleteGroups();
@@ -762,6 +808,11 @@ struct VIEW::updateItemsColor
         const COLOR4D color = painter->GetSettings()->GetColor( aItem, layer );
         int group = aItem->viewPrivData()->getGroup( layer );
 
+        if( group >= 0 )
+            gal->ChangeGroupColor( group, color );
+
+        group = aItem->viewPrivData()->getStandInGroup( layer );
+
         if( group >= 0 )
             gal->ChangeGroupColor( group, color );
 
@@ -816,6 +867,11 @@ void VIEW::UpdateAllLayersColor()
                 const COLOR4D color = m_painter->GetSettings()->GetColor( item, layers[i] );
                 int group = viewData->getGroup( layers[i] );
 
+                if( group >= 0 )
+                    m_gal->ChangeGroupColor( group, color );
+
+                group = viewData->getStandInGroup( layers[i] );
+
                 if( group >= 0 )
                     m_gal->ChangeGroupColor( group, color );
             }
@@ -837,6 +893,11 @@ struct VIEW::changeItemsDepth
     {
         int group = aItem->viewPrivData()->getGroup( layer );
 
+        if( group >= 0 )
+            gal->ChangeGroupDepth( group, depth );
+
+        group = aItem->viewPrivData()->getStandInGroup( layer );
+
         if( group >= 0 )
             gal->ChangeGroupDepth( group, depth );
 
@@ -944,10 +1005,16 @@ void VIEW::UpdateAllLayersOrder()
 
             for( int i = 0; i < layers_count; ++i )
             {
+                int depth = m_layers[layers[i]].renderingOrder;
                 int group = viewData->getGroup( layers[i] );
 
                 if( group >= 0 )
-                    m_gal->ChangeGroupDepth( group, m_layers[layers[i]].renderingOrder );
+                    m_gal->ChangeGroupDepth( group, depth );
+
+                group = viewData->getStandInGroup( layers[i] );
+
+                if( group >= 0 )
+                    m_gal->ChangeGroupDepth( group, depth );
             }
         }
     }
@@ -958,10 +1025,12 @@ void VIEW::UpdateAllLayersOrder()
 
 struct VIEW::drawItem
 {
-    drawItem( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder ) :
+    drawItem( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder,
+              double aMinSize = 0.0 ) :
         view( aView ), layer( aLayer ),
         useDrawPriority( aUseDrawPriority ),
-        reverseDrawOrder( aReverseDrawOrder )
+        reverseDrawOrder( aReverseDrawOrder ),
+        minSize( aMinSize )
     {
     }
 
@@ -978,11 +1047,28 @@ struct VIEW::drawItem
         if( useDrawPriority )
             drawItems.push_back( aItem );
         else
-            view->draw( aItem, layer );
+            draw( aItem );
 
         return true;
     }
 
+    void draw( VIEW_ITEM* aItem )
+    {
+        // Items that would not cover a visible area on the screen are drawn simplified
+        if( minSize > 0.0 )
+        {
+            const BOX2I bbox = aItem->ViewBBox();
+
+            if( std::max( bbox.GetWidth(), bbox.GetHeight() ) < minSize )
+            {
+                view->drawStandIn( aItem, layer );
+                return;
+            }
+        }
+
+        view->draw( aItem, layer );
+    }
+
     void deferredDraw()
     {
         if( reverseDrawOrder )
@@ -997,23 +1083,32 @@ struct VIEW::drawItem
                        });
 
         for( auto item : drawItems )
-            view->draw( item, layer );
+            draw( item );
     }
 
     VIEW* view;
     int layer, layers[VIEW_MAX_LAYERS];
     bool useDrawPriority, reverseDrawOrder;
+    double minSize;
     std::vector<VIEW_ITEM*> drawItems;
 };
 
 
 void VIEW::redrawRect( const BOX2I& aRect )
 {
+    // Minimal size (in world units) of the items to be drawn on cached layers.  Overlay
+    // and noncached targets hold the interactive stuff, which is always drawn.
+    double minSize = 0.0;
+
+    if( m_minItemScreenSize > 0.0 && m_printMode <= 0 )
+        minSize = ToWorld( m_minItemScreenSize );
+
     for( VIEW_LAYER* l : m_orderedLayers )
     {
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
-            drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
+            drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder,
+                               l->target == TARGET_CACHED ? minSize : 0.0 );
 
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
@@ -1076,6 +1171,43 @@ void VIEW::draw( VIEW_GROUP* aGroup, bool aImmediate )
 }
 
 
+void VIEW::drawStandIn( VIEW_ITEM* aItem, int aLayer )
+{
+    auto viewData = aItem->viewPrivData();
+
+    if( !viewData )
+        return;
+
+    int group = viewData->getStandInGroup( aLayer );
+
+    if( group < 0 )
+    {
+        // The line does not depend on the zoom level (GALs draw lines at least one pixel
+        // wide), so it can be cached like the full item
+        const BOX2I bbox = aItem->ViewBBox();
+        VECTOR2D    start = bbox.GetOrigin();
+        VECTOR2D    end = bbox.GetEnd();
+
+        // A zero length line has no direction to be drawn along
+        if( start == end )
+            end.x += 1.0;
+
+        group = m_gal->BeginGroup();
+        viewData->setStandInGroup( aLayer, group );
+
+        m_gal->SetIsFill( false );
+        m_gal->SetIsStroke( true );
+        m_gal->SetLineWidth( 0.0 );
+        m_gal->SetStrokeColor( m_painter->GetSettings()->GetColor( aItem, aLayer ) );
+        m_gal->DrawLine( start, end );
+
+        m_gal->EndGroup();
+    }
+
+    m_gal->DrawGroup( group );
+}
+
+
 struct VIEW::recacheItem
 {
     recacheItem( VIEW* aView, GAL* aGal, int aLayer ) :
@@ -1097,6 +1229,7 @@ struct VIEW::recacheItem
             gal->DeleteGroup( group );
 
         viewData->setGroup( layer, -1 );
+        viewData->deleteStandInGroup( gal, layer );
         view->Update( aItem );
 
         return true;
@@ -1289,16 +1422,20 @@ void VIEW::updateItemColor( VIEW_ITEM* aItem, int aLayer )
     // Change the color, only if it has group assigned
     if( group >= 0 )
         m_gal->ChangeGroupColor( group, color );
+
+    group = viewData->getStandInGroup( aLayer );
+
+    if( group >= 0 )
+        m_gal->ChangeGroupColor( group, color );
 }
 
 
 void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
 {
-    auto viewData = aItem->viewPrivData();
     wxCHECK( (unsigned) aLayer < m_layers.size(), /*void*/ );
     wxCHECK( IsCached( aLayer ), /*void*/ );
 
-    if( !viewData )
+    if( !aItem->viewPrivData() )
         return;
 
     VIEW_LAYER& l = m_layers.at( aLayer );
@@ -1306,12 +1443,23 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     m_gal->SetTarget( l.target );
     m_gal->SetLayerDepth( l.renderingOrder );
 
+    cacheItemGeometry( aItem, aLayer );
+}
+
+
+void VIEW::cacheItemGeometry( VIEW_ITEM* aItem, int aLayer )
+{
+    auto viewData = aItem->viewPrivData();
+
     // Redraw the item from scratch
     int group = viewData->getGroup( aLayer );
 
     if( group >= 0 )
         m_gal->DeleteGroup( group );
 
+    // The simplified representation is recreated from the new geometry when needed
+    viewData->deleteStandInGroup( m_gal, aLayer );
+
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
@@ -1365,6 +1513,8 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
                 m_gal->DeleteGroup( prevGroup );
                 viewData->setGroup( l.id, -1 );
             }
+
+            viewData->deleteStandInGroup( m_gal, l.id );
         }
     }
 
@@ -1422,21 +1572,96 @@ void VIEW::UpdateItems()
 {
     if( m_gal->IsVisible() )
     {
-        GAL_UPDATE_CONTEXT ctx( m_gal );
+        std::vector<VIEW_ITEM*> dirtyItems;
 
         for( VIEW_ITEM* item : *m_allItems )
         {
             auto viewData = item->viewPrivData();
 
-            if( !viewData )
-                continue;
+            if( viewData && viewData->m_requiredUpdate != NONE )
+                dirtyItems.push_back( item );
+        }
+
+        if( dirtyItems.empty() )
+            return;
 
-            if( viewData->m_requiredUpdate != NONE )
+        GAL_UPDATE_CONTEXT ctx( m_gal );
+
+        invalidateItems( dirtyItems );
+    }
+}
+
+
+void VIEW::invalidateItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    // Items are first sorted into per-layer buckets, so the GAL target and layer depth are
+    // switched once per layer instead of once per item and layer.
+    std::vector<std::vector<VIEW_ITEM*>> geometryUpdates( VIEW_MAX_LAYERS );
+    std::vector<std::vector<VIEW_ITEM*>> colorUpdates( VIEW_MAX_LAYERS );
+    std::bitset<VIEW_MAX_LAYERS> dirtyLayers;
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        auto viewData = item->viewPrivData();
+        int  flags = viewData->m_requiredUpdate;
+
+        if( flags & INITIAL_ADD )
+        {
+            // Don't update layers or bbox, since it was done in VIEW::Add()
+            flags = ALL;
+        }
+        else if( flags & LAYERS )
+        {
+            // updateLayers updates geometry too
+            updateLayers( item );
+        }
+        else if( flags & GEOMETRY )
+        {
+            updateBbox( item );
+        }
+
+        int layers[VIEW_MAX_LAYERS], layers_count;
+        item->ViewGetLayers( layers, layers_count );
+
+        for( int i = 0; i < layers_count; ++i )
+        {
+            int layerId = layers[i];
+
+            if( IsCached( layerId ) )
             {
-                invalidateItem( item, viewData->m_requiredUpdate );
-                viewData->m_requiredUpdate = NONE;
+                if( flags & ( GEOMETRY | LAYERS | REPAINT ) )
+                    geometryUpdates[layerId].push_back( item );
+                else if( flags & COLOR )
+                    colorUpdates[layerId].push_back( item );
             }
+
+            dirtyLayers.set( layerId );
         }
+
+        viewData->clearUpdateFlags();
+    }
+
+    for( int layerId = 0; layerId < VIEW_MAX_LAYERS; ++layerId )
+    {
+        if( !dirtyLayers.test( layerId ) )
+            continue;
+
+        VIEW_LAYER& l = m_layers[layerId];
+
+        if( !geometryUpdates[layerId].empty() )
+        {
+            m_gal->SetTarget( l.target );
+            m_gal->SetLayerDepth( l.renderingOrder );
+
+            for( VIEW_ITEM* item : geometryUpdates[layerId] )
+                cacheItemGeometry( item, layerId );
+        }
+
+        for( VIEW_ITEM* item : colorUpdates[layerId] )
+            updateItemColor( item, layerId );
+
+        // Mark the layer as dirty, so the VIEW will be refreshed
+        MarkTargetDirty( l.target );
     }
 }
 
@@ -3278,6 +3278,7 @@ IMPLEMENT_DYNAMIC_CLASS( mpFXYVector, mpFXY )
 mpFXYVector::mpFXYVector( const wxString& name, int flags ) : mpFXY( name, flags )
 {
     m_index = 0;
+    m_decimated = false;
     // printf("FXYVector::FXYVector!\n");
     m_minX  = -1;
     m_maxX  = 1;
@@ -3346,21 +3347,24 @@ void mpFXYVector::Rewind()
 
 size_t mpFXYVector::GetCount()
 {
-    return m_xs.size();
+    return m_decimated ? m_decimatedXs.size() : m_xs.size();
 }
 
 
 bool mpFXYVector::GetNextXY( double& x, double& y )
 {
-    if( m_index >= m_xs.size() )
+    const std::vector<double>& xs = m_decimated ? m_decimatedXs : m_xs;
+    const std::vector<double>& ys = m_decimated ? m_decimatedYs : m_ys;
+
+    if( m_index >= xs.size() )
     {
         return false;
     }
     else
     {
-        x = m_xs[m_index];
-        y = m_ys[m_index++];
-        return m_index <= m_xs.size();
+        x = xs[m_index];
+        y = ys[m_index++];
+        return m_index <= xs.size();
     }
 }
 
@@ -3369,54 +3373,199 @@ void mpFXYVector::Clear()
 {
     m_xs.clear();
     m_ys.clear();
+    m_minmax.clear();
 }
 
 
-void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<double>& ys )
+/** Merges the extremes of two consecutive ranges of points
+ */
+static void mergeMinMax( double aFirst, double aSecond, double aThird, double aFourth,
+                         double& aMergedFirst, double& aMergedSecond )
 {
-    // Check if the data vectora are of the same size
-    if( xs.size() != ys.size() )
+    const double values[4] = { aFirst, aSecond, aThird, aFourth };
+    int          minIdx = 0;
+    int          maxIdx = 0;
+
+    for( int i = 1; i < 4; i++ )
     {
-        wxLogError( "wxMathPlot error: X and Y vector are not of the same length!" );
-        return;
+        if( values[i] < values[minIdx] )
+            minIdx = i;
+
+        if( values[i] > values[maxIdx] )
+            maxIdx = i;
     }
 
-    // Copy the data:
-    m_xs    = xs;
-    m_ys    = ys;
+    aMergedFirst = values[std::min( minIdx, maxIdx )];
+    aMergedSecond = values[std::max( minIdx, maxIdx )];
+}
 
-    // printf("FXYVector::setData %d %d\n", xs.size(), ys.size());
 
-    // Update internal variables for the bounding box.
-    if( xs.size()>0 )
+void mpFXYVector::buildMinMax( size_t aFirst )
+{
+    // The data before aFirst can only be trusted to be sorted if it has a pyramid
+    if( m_minmax.empty() )
+        aFirst = 0;
+
+    size_t sortedFrom = aFirst > 0 ? aFirst - 1 : 0;
+
+    if( m_ys.size() < DECIMATION_MIN_POINTS
+            || !std::is_sorted( m_xs.begin() + sortedFrom, m_xs.end() ) )
     {
-        m_minX  = xs[0];
-        m_maxX  = xs[0];
-        m_minY  = ys[0];
-        m_maxY  = ys[0];
+        m_minmax.clear();
+        return;
+    }
+
+    if( aFirst == 0 )
+        m_minmax.clear();
+
+    if( m_minmax.empty() )
+        m_minmax.emplace_back();
+
+    // First level, from the points.  Only the buckets from the one holding aFirst change.
+    std::vector<MINMAX>& level = m_minmax[0];
+    size_t               firstBucket = aFirst / DECIMATION_BUCKET;
+
+    level.resize( ( m_ys.size() + DECIMATION_BUCKET - 1 ) / DECIMATION_BUCKET );
 
-        std::vector<double>::const_iterator it;
+    for( size_t i = firstBucket; i < level.size(); i++ )
+    {
+        size_t begin = i * DECIMATION_BUCKET;
+        size_t end = std::min( begin + DECIMATION_BUCKET, m_ys.size() );
+        size_t minIdx = begin;
+        size_t maxIdx = begin;
 
-        for( it = xs.begin(); it!=xs.end(); it++ )
+        for( size_t j = begin + 1; j < end; j++ )
         {
-            if( *it<m_minX )
-                m_minX = *it;
+            if( m_ys[j] < m_ys[minIdx] )
+                minIdx = j;
 
-            if( *it>m_maxX )
-                m_maxX = *it;
+            if( m_ys[j] > m_ys[maxIdx] )
+                maxIdx = j;
         }
 
-        for( it = ys.begin(); it!=ys.end(); it++ )
+        level[i].first = m_ys[std::min( minIdx, maxIdx )];
+        level[i].second = m_ys[std::max( minIdx, maxIdx )];
+    }
+
+    // Next levels, each one merging pairs of buckets of the previous one
+    size_t depth = 1;
+
+    for( ; m_minmax[depth - 1].size() > 1; depth++ )
+    {
+        if( depth == m_minmax.size() )
+            m_minmax.emplace_back();
+
+        const std::vector<MINMAX>& prev = m_minmax[depth - 1];
+        std::vector<MINMAX>&       next = m_minmax[depth];
+
+        firstBucket /= 2;
+        next.resize( ( prev.size() + 1 ) / 2 );
+
+        for( size_t i = firstBucket; i < next.size(); i++ )
         {
-            if( *it<m_minY )
-                m_minY = *it;
+            const MINMAX& a = prev[2 * i];
+            const MINMAX& b = 2 * i + 1 < prev.size() ? prev[2 * i + 1] : a;
 
-            if( *it>m_maxY )
-                m_maxY = *it;
+            mergeMinMax( a.first, a.second, b.first, b.second, next[i].first, next[i].second );
         }
+    }
+
+    m_minmax.resize( depth );
+}
+
+
+bool mpFXYVector::decimate( mpWindow& w )
+{
+    if( m_minmax.empty() )
+        return false;
+
+    wxCoord startPx = m_drawOutsideMargins ? 0 : w.GetMarginLeft();
+    wxCoord endPx   = m_drawOutsideMargins ? w.GetScrX() : w.GetScrX() - w.GetMarginRight();
+    double  minX = s2x( w.p2x( startPx ) );
+    double  maxX = s2x( w.p2x( endPx ) );
+
+    if( minX > maxX )
+        std::swap( minX, maxX );
+
+    // The visible points, and one more on each side for the lines leaving the view
+    size_t begin = std::lower_bound( m_xs.begin(), m_xs.end(), minX ) - m_xs.begin();
+    size_t end = std::upper_bound( m_xs.begin(), m_xs.end(), maxX ) - m_xs.begin();
 
-        // printf("minX %.10f maxX %.10f\n ", m_minX, m_maxX );
-        // printf("minY %.10f maxY %.10f\n ", m_minY, m_maxY );
+    begin = begin > 0 ? begin - 1 : 0;
+    end = std::min( end + 1, m_xs.size() );
+
+    // Use the coarsest level with at least two buckets per pixel column
+    size_t columns = std::max( endPx - startPx, 1 );
+    size_t pointsPerBucket = ( end - begin ) / ( 2 * columns );
+    int    level = -1;
+
+    while( level + 1 < (int) m_minmax.size()
+           && ( DECIMATION_BUCKET << ( level + 1 ) ) <= pointsPerBucket )
+    {
+        level++;
+    }
+
+    if( level < 0 )
+        return false;
+
+    const std::vector<MINMAX>& buckets = m_minmax[level];
+    size_t                     bucketSize = DECIMATION_BUCKET << level;
+    size_t                     firstBucket = begin / bucketSize;
+    size_t                     lastBucket = ( end - 1 ) / bucketSize;
+
+    m_decimatedXs.clear();
+    m_decimatedYs.clear();
+    m_decimatedXs.reserve( 2 * ( lastBucket - firstBucket + 1 ) );
+    m_decimatedYs.reserve( 2 * ( lastBucket - firstBucket + 1 ) );
+
+    // A bucket is narrower than a pixel: draw its extremes at its ends
+    for( size_t i = firstBucket; i <= lastBucket; i++ )
+    {
+        size_t bucketBegin = i * bucketSize;
+        size_t bucketEnd = std::min( bucketBegin + bucketSize, m_xs.size() );
+
+        m_decimatedXs.push_back( m_xs[bucketBegin] );
+        m_decimatedYs.push_back( buckets[i].first );
+        m_decimatedXs.push_back( m_xs[bucketEnd - 1] );
+        m_decimatedYs.push_back( buckets[i].second );
+    }
+
+    return true;
+}
+
+
+void mpFXYVector::Plot( wxDC& dc, mpWindow& w )
+{
+    m_decimated = m_visible && m_continuous && decimate( w );
+
+    mpFXY::Plot( dc, w );
+
+    m_decimated = false;
+}
+
+
+void mpFXYVector::SetData( std::vector<double> xs, std::vector<double> ys )
+{
+    // Check if the data vectora are of the same size
+    if( xs.size() != ys.size() )
+    {
+        wxLogError( "wxMathPlot error: X and Y vector are not of the same length!" );
+        return;
+    }
+
+    // Take the data over
+    m_xs    = std::move( xs );
+    m_ys    = std::move( ys );
+
+    // Update internal variables for the bounding box.
+    if( m_xs.size()>0 )
+    {
+        m_minX  = m_xs[0];
+        m_maxX  = m_xs[0];
+        m_minY  = m_ys[0];
+        m_maxY  = m_ys[0];
+
+        updateBounds( 1 );
     }
     else
     {
@@ -3425,6 +3574,51 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
         m_minY  = -1;
         m_maxY  = 1;
     }
+
+    buildMinMax( 0 );
+}
+
+
+void mpFXYVector::AppendData( const std::vector<double>& xs, const std::vector<double>& ys )
+{
+    if( xs.size() != ys.size() )
+    {
+        wxLogError( "wxMathPlot error: X and Y vector are not of the same length!" );
+        return;
+    }
+
+    if( m_xs.empty() )
+    {
+        SetData( xs, ys );
+        return;
+    }
+
+    size_t first = m_xs.size();
+
+    m_xs.insert( m_xs.end(), xs.begin(), xs.end() );
+    m_ys.insert( m_ys.end(), ys.begin(), ys.end() );
+
+    updateBounds( first );
+    buildMinMax( first );
+}
+
+
+void mpFXYVector::updateBounds( size_t aFirst )
+{
+    for( size_t i = aFirst; i < m_xs.size(); i++ )
+    {
+        if( m_xs[i]<m_minX )
+            m_minX = m_xs[i];
+
+        if( m_xs[i]>m_maxX )
+            m_maxX = m_xs[i];
+
+        if( m_ys[i]<m_minY )
+            m_minY = m_ys[i];
+
+        if( m_ys[i]>m_maxY )
+            m_maxY = m_ys[i];
+    }
 }
 
 
@@ -318,6 +318,16 @@ void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER&, int )
 }
 
 
+/**
+ * Virtual function needed by the PCB_SCREEN class derived from BASE_SCREEN
+ * do nothing in Cvpcb, which has no undo
+ */
+size_t PCB_SCREEN::GetCommandMemoryUsage( const PICKED_ITEMS_LIST& ) const
+{
+    return 0;
+}
+
+
 COLOR4D DISPLAY_FOOTPRINTS_FRAME::GetGridColor()
 {
     return COLOR4D( DARKGRAY );
@@ -24,6 +24,8 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <functional>
 #include <profile.h>
 
 #include <common.h>
@@ -39,6 +41,7 @@
 #include <sch_sheet_path.h>
 #include <sch_text.h>
 #include <schematic.h>
+#include <trigo.h>
 
 #include <advanced_config.h>
 #include <connection_graph.h>
@@ -364,6 +367,7 @@ void CONNECTION_GRAPH::Reset()
     m_net_name_to_subgraphs_map.clear();
     m_local_label_cache.clear();
     m_global_label_cache.clear();
+    m_link_key_map.clear();
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
@@ -373,36 +377,46 @@ void CONNECTION_GRAPH::Reset()
 void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional )
 {
     PROF_COUNTER recalc_time;
-    PROF_COUNTER update_items;
 
-    if( aUnconditional )
-        Reset();
-
-    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    if( aUnconditional || !recalculateDirty( aSheetList ) )
     {
-        std::vector<SCH_ITEM*> items;
+        PROF_COUNTER update_items;
 
-        for( auto item : sheet.LastScreen()->Items() )
+        Reset();
+
+        for( const SCH_SHEET_PATH& sheet : aSheetList )
         {
-            if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
-                items.push_back( item );
-        }
+            std::vector<SCH_ITEM*> items;
 
-        updateItemConnectivity( sheet, items );
+            for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+            {
+                if( item->IsConnectable() )
+                {
+                    item->ConnectedItems( sheet ).clear();
+                    item->SetConnectivityDirty( false );
+                    getConnectableItems( sheet, item, items );
+                }
+            }
 
-        // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet );
-    }
+            for( SCH_ITEM* item : items )
+                item->SetConnectivityDirty( false );
 
-    update_items.Stop();
-    wxLogTrace( "CONN_PROFILE", "UpdateItemConnectivity() %0.4f ms", update_items.msecs() );
+            updateItemConnectivity( sheet, items );
 
-    PROF_COUNTER build_graph;
+            // UpdateDanglingState() also adds connected items for SCH_TEXT
+            sheet.LastScreen()->TestDanglingEnds( &sheet );
+        }
 
-    buildConnectionGraph();
+        update_items.Stop();
+        wxLogTrace( "CONN_PROFILE", "UpdateItemConnectivity() %0.4f ms", update_items.msecs() );
 
-    build_graph.Stop();
-    wxLogTrace( "CONN_PROFILE", "BuildConnectionGraph() %0.4f ms", build_graph.msecs() );
+        PROF_COUNTER build_graph;
+
+        buildConnectionGraph();
+
+        build_graph.Stop();
+        wxLogTrace( "CONN_PROFILE", "BuildConnectionGraph() %0.4f ms", build_graph.msecs() );
+    }
 
     recalc_time.Stop();
     wxLogTrace( "CONN_PROFILE", "Recalculate time %0.4f ms", recalc_time.msecs() );
@@ -420,6 +434,677 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 }
 
 
+void CONNECTION_GRAPH::getConnectableItems( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem,
+                                            std::vector<SCH_ITEM*>& aItems )
+{
+    if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( aItem )->GetPins() )
+            aItems.push_back( pin );
+    }
+    else if( aItem->Type() == SCH_COMPONENT_T )
+    {
+        for( SCH_PIN* pin : static_cast<SCH_COMPONENT*>( aItem )->GetSchPins( &aSheet ) )
+            aItems.push_back( pin );
+    }
+    else
+    {
+        aItems.push_back( aItem );
+    }
+}
+
+
+void CONNECTION_GRAPH::getConnectionPoints( SCH_ITEM* aItem, std::vector<wxPoint>& aPoints )
+{
+    if( aItem->Type() == SCH_SHEET_PIN_T )
+        aPoints.push_back( static_cast<SCH_SHEET_PIN*>( aItem )->GetTextPos() );
+    else if( aItem->Type() == SCH_PIN_T )
+        aPoints.push_back( static_cast<SCH_PIN*>( aItem )->GetPosition() );
+    else
+        aItem->GetConnectionPoints( aPoints );
+}
+
+
+void CONNECTION_GRAPH::getTouchingItems( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem,
+                                         std::vector<SCH_ITEM*>& aItems )
+{
+    EE_RTREE&              screenItems = aSheet.LastScreen()->Items();
+    std::vector<wxPoint>   points;
+    std::vector<SCH_ITEM*> candidates;
+
+    getConnectionPoints( aItem, points );
+
+    for( const wxPoint& point : points )
+    {
+        for( SCH_ITEM* item : screenItems.Overlapping( point ) )
+        {
+            if( item->IsConnectable() )
+                getConnectableItems( aSheet, item, candidates );
+        }
+    }
+
+    SCH_LINE* line = nullptr;
+
+    if( aItem->Type() == SCH_LINE_T )
+    {
+        line = static_cast<SCH_LINE*>( aItem );
+
+        for( SCH_ITEM* item : screenItems.Overlapping( line->GetBoundingBox() ) )
+        {
+            if( item->IsConnectable() )
+                getConnectableItems( aSheet, item, candidates );
+        }
+    }
+
+    std::sort( candidates.begin(), candidates.end() );
+    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+    for( SCH_ITEM* candidate : candidates )
+    {
+        if( candidate == aItem )
+            continue;
+
+        std::vector<wxPoint> candidatePoints;
+        getConnectionPoints( candidate, candidatePoints );
+
+        bool touching = false;
+
+        for( const wxPoint& point : candidatePoints )
+        {
+            if( std::find( points.begin(), points.end(), point ) != points.end()
+                    || ( line && TestSegmentHit( point, line->GetStartPoint(),
+                                                 line->GetEndPoint(), 0 ) ) )
+            {
+                touching = true;
+                break;
+            }
+        }
+
+        if( !touching && candidate->Type() == SCH_LINE_T )
+        {
+            SCH_LINE* candidateLine = static_cast<SCH_LINE*>( candidate );
+
+            for( const wxPoint& point : points )
+            {
+                if( TestSegmentHit( point, candidateLine->GetStartPoint(),
+                                    candidateLine->GetEndPoint(), 0 ) )
+                {
+                    touching = true;
+                    break;
+                }
+            }
+        }
+
+        if( touching )
+            aItems.push_back( candidate );
+    }
+}
+
+
+void CONNECTION_GRAPH::getLinkKeys( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet,
+                                    std::vector<wxString>& aKeys )
+{
+    wxString path = aSheet.PathAsString();
+    wxString name;
+    bool     global = false;
+
+    switch( aItem->Type() )
+    {
+    case SCH_PIN_T:
+    {
+        SCH_PIN* pin = static_cast<SCH_PIN*>( aItem );
+
+        if( !pin->IsPowerConnection() )
+        {
+            // Pins only link through the weak net names that could collide
+            aKeys.push_back( "W:" + pin->GetDefaultNetName( aSheet ) );
+            return;
+        }
+
+        name = pin->GetName();
+        global = true;
+        break;
+    }
+
+    case SCH_LABEL_T:
+        name = static_cast<SCH_TEXT*>( aItem )->GetShownText();
+        break;
+
+    case SCH_GLOBAL_LABEL_T:
+        name = static_cast<SCH_TEXT*>( aItem )->GetShownText();
+        global = true;
+        break;
+
+    case SCH_HIER_LABEL_T:
+        name = static_cast<SCH_TEXT*>( aItem )->GetShownText();
+        aKeys.push_back( "H:" + path + "\t" + name );
+        break;
+
+    case SCH_SHEET_PIN_T:
+    {
+        SCH_SHEET_PIN* pin = static_cast<SCH_SHEET_PIN*>( aItem );
+        SCH_SHEET_PATH child = aSheet;
+
+        child.push_back( pin->GetParent() );
+        name = pin->GetShownText();
+        aKeys.push_back( "H:" + child.PathAsString() + "\t" + name );
+        break;
+    }
+
+    default:
+        return;
+    }
+
+    std::function<void( const wxString& )> addName =
+            [&]( const wxString& aName )
+            {
+                aKeys.push_back( "L:" + path + "\t" + aName );
+
+                if( global )
+                    aKeys.push_back( "G:" + aName );
+
+                wxString              prefix;
+                std::vector<wxString> members;
+
+                if( SCH_CONNECTION::ParseBusVector( aName, &prefix, &members ) )
+                {
+                    for( const wxString& member : members )
+                        addName( member );
+                }
+                else if( SCH_CONNECTION::ParseBusGroup( aName, &prefix, &members ) )
+                {
+                    for( const wxString& member : members )
+                    {
+                        addName( member );
+
+                        if( !prefix.IsEmpty() )
+                            addName( prefix + "." + member );
+                    }
+                }
+            };
+
+    addName( name );
+}
+
+
+void CONNECTION_GRAPH::cacheLinkKeys( CONNECTION_SUBGRAPH* aSubgraph )
+{
+    std::vector<wxString>& keys = aSubgraph->m_link_keys;
+
+    keys.clear();
+
+    std::function<void( SCH_CONNECTION* )> addNetNames =
+            [&]( SCH_CONNECTION* aConnection )
+            {
+                keys.push_back( "N:" + aConnection->Name() );
+
+                for( const auto& member : aConnection->Members() )
+                    addNetNames( member.get() );
+            };
+
+    if( aSubgraph->m_driver_connection )
+        addNetNames( aSubgraph->m_driver_connection );
+
+    for( SCH_ITEM* item : aSubgraph->m_items )
+        getLinkKeys( item, aSubgraph->m_sheet, keys );
+
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+    for( const wxString& key : keys )
+        m_link_key_map[ key ].push_back( aSubgraph );
+}
+
+
+bool CONNECTION_GRAPH::recalculateDirty( const SCH_SHEET_LIST& aSheetList )
+{
+    if( m_subgraphs.empty() )
+        return false;
+
+    PROF_COUNTER recalc_dirty;
+
+    // Bus aliases are not tracked by the dirty flags, and a change in one can rename
+    // nets anywhere in the schematic
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        if( !sheet.LastScreen()->GetBusAliases().empty() )
+            return false;
+    }
+
+    // Find the dirty and removed items.  Nothing is changed until we know we can go on.
+
+    std::unordered_set<SCH_ITEM*> live_items;
+    std::unordered_set<SCH_ITEM*> dirty_items;
+    std::vector<SCH_ITEM*>        dirty_screen_items;
+
+    std::vector<std::pair<SCH_SHEET_PATH, std::vector<SCH_ITEM*>>> dirty_by_sheet;
+
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        std::vector<SCH_ITEM*> dirty;
+
+        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+        {
+            if( !item->IsConnectable() )
+                continue;
+
+            std::vector<SCH_ITEM*> connectables;
+            getConnectableItems( sheet, item, connectables );
+
+            bool is_dirty = item->IsConnectivityDirty();
+
+            for( SCH_ITEM* connectable : connectables )
+            {
+                live_items.insert( connectable );
+
+                if( connectable->IsConnectivityDirty() || !m_items.count( connectable )
+                        || !connectable->Connection( sheet ) )
+                {
+                    is_dirty = true;
+                }
+            }
+
+            if( !is_dirty )
+                continue;
+
+            // Sheet pins rename nets through the whole sub-hierarchy
+            if( item->Type() == SCH_SHEET_T )
+                return false;
+
+            dirty_screen_items.push_back( item );
+            dirty_items.insert( connectables.begin(), connectables.end() );
+            dirty.insert( dirty.end(), connectables.begin(), connectables.end() );
+        }
+
+        dirty_by_sheet.emplace_back( sheet, std::move( dirty ) );
+    }
+
+    // The removed items may have been deleted already: they are only compared, never used
+    std::unordered_set<SCH_ITEM*> dead_items;
+
+    for( SCH_ITEM* item : m_items )
+    {
+        if( !live_items.count( item ) )
+            dead_items.insert( item );
+    }
+
+    if( dirty_items.empty() && dead_items.empty() )
+        return true;
+
+    // Find the subgraphs that must be rebuilt: the ones holding changed items, the ones
+    // touching the dirty items, and from there all the subgraphs they are linked to
+
+    std::unordered_map<long, CONNECTION_SUBGRAPH*> code_to_subgraph;
+    std::unordered_set<CONNECTION_SUBGRAPH*>       live_subgraphs( m_subgraphs.begin(),
+                                                                   m_subgraphs.end() );
+    std::unordered_map<CONNECTION_SUBGRAPH*, std::vector<CONNECTION_SUBGRAPH*>> back_links;
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+    {
+        code_to_subgraph[ subgraph->m_code ] = subgraph;
+
+        for( const auto& it : subgraph->m_bus_neighbors )
+        {
+            for( CONNECTION_SUBGRAPH* neighbor : it.second )
+                back_links[ neighbor ].push_back( subgraph );
+        }
+
+        for( const auto& it : subgraph->m_bus_parents )
+        {
+            for( CONNECTION_SUBGRAPH* parent : it.second )
+                back_links[ parent ].push_back( subgraph );
+        }
+
+        if( subgraph->m_hier_parent )
+            back_links[ subgraph->m_hier_parent ].push_back( subgraph );
+    }
+
+    std::unordered_set<CONNECTION_SUBGRAPH*> affected;
+    std::vector<CONNECTION_SUBGRAPH*>        queue;
+    bool                                     consistent = true;
+
+    auto affect =
+            [&]( CONNECTION_SUBGRAPH* aSubgraph )
+            {
+                if( live_subgraphs.count( aSubgraph ) && affected.insert( aSubgraph ).second )
+                {
+                    queue.push_back( aSubgraph );
+                }
+            };
+
+    auto affectTouching =
+            [&]( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem )
+            {
+                std::vector<SCH_ITEM*> touching;
+                getTouchingItems( aSheet, aItem, touching );
+
+                for( SCH_ITEM* other : touching )
+                {
+                    if( dirty_items.count( other ) )
+                        continue;
+
+                    SCH_CONNECTION* conn = other->Connection( aSheet );
+
+                    if( conn && code_to_subgraph.count( conn->SubgraphCode() ) )
+                        affect( code_to_subgraph.at( conn->SubgraphCode() ) );
+                    else
+                        consistent = false;
+                }
+            };
+
+    auto affectLinked =
+            [&]( const wxString& aKey )
+            {
+                auto it = m_link_key_map.find( aKey );
+
+                if( it != m_link_key_map.end() )
+                {
+                    for( CONNECTION_SUBGRAPH* subgraph : it->second )
+                        affect( subgraph );
+                }
+            };
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+    {
+        for( SCH_ITEM* item : subgraph->m_items )
+        {
+            if( dead_items.count( item ) || dirty_items.count( item ) )
+            {
+                affect( subgraph );
+                break;
+            }
+        }
+    }
+
+    std::vector<wxString> keys;
+
+    for( const auto& it : dirty_by_sheet )
+    {
+        for( SCH_ITEM* item : it.second )
+        {
+            affectTouching( it.first, item );
+
+            keys.clear();
+            getLinkKeys( item, it.first, keys );
+
+            for( const wxString& key : keys )
+                affectLinked( key );
+        }
+    }
+
+    for( size_t i = 0; i < queue.size() && consistent; ++i )
+    {
+        CONNECTION_SUBGRAPH* subgraph = queue[i];
+
+        for( SCH_ITEM* item : subgraph->m_items )
+        {
+            if( dead_items.count( item ) || dirty_items.count( item ) )
+                continue;
+
+            affectTouching( subgraph->m_sheet, item );
+
+            keys.clear();
+            getLinkKeys( item, subgraph->m_sheet, keys );
+
+            for( const wxString& key : keys )
+                affectLinked( key );
+        }
+
+        for( const wxString& key : subgraph->m_link_keys )
+            affectLinked( key );
+
+        for( const auto& it : subgraph->m_bus_neighbors )
+        {
+            for( CONNECTION_SUBGRAPH* neighbor : it.second )
+                affect( neighbor );
+        }
+
+        for( const auto& it : subgraph->m_bus_parents )
+        {
+            for( CONNECTION_SUBGRAPH* parent : it.second )
+                affect( parent );
+        }
+
+        affect( subgraph->m_hier_parent );
+
+        if( back_links.count( subgraph ) )
+        {
+            for( CONNECTION_SUBGRAPH* child : back_links.at( subgraph ) )
+                affect( child );
+        }
+
+        // Past this point a full recalculation is as fast and much simpler
+        if( affected.size() * 2 > m_subgraphs.size() )
+            return false;
+    }
+
+    if( !consistent )
+        return false;
+
+    // Collect the items to rebuild: the remaining items of the affected subgraphs and the
+    // dirty items
+
+    std::unordered_map<SCH_SHEET_PATH, std::vector<SCH_ITEM*>> rebuild_items;
+
+    for( CONNECTION_SUBGRAPH* subgraph : affected )
+    {
+        for( SCH_ITEM* item : subgraph->m_items )
+        {
+            if( !dead_items.count( item ) && !dirty_items.count( item ) )
+                rebuild_items[ subgraph->m_sheet ].push_back( item );
+        }
+    }
+
+    for( const auto& it : dirty_by_sheet )
+    {
+        if( it.second.empty() )
+            continue;
+
+        std::vector<SCH_ITEM*>& items = rebuild_items[ it.first ];
+        items.insert( items.end(), it.second.begin(), it.second.end() );
+    }
+
+    // Remove the affected subgraphs and the removed items from the graph
+
+    auto isAffected =
+            [&]( const CONNECTION_SUBGRAPH* aSubgraph )
+            {
+                return affected.count( const_cast<CONNECTION_SUBGRAPH*>( aSubgraph ) ) > 0;
+            };
+
+    auto eraseAffected =
+            [&]( auto& aCache )
+            {
+                for( auto it = aCache.begin(); it != aCache.end(); )
+                {
+                    auto& subgraphs = it->second;
+
+                    subgraphs.erase( std::remove_if( subgraphs.begin(), subgraphs.end(),
+                                                     isAffected ),
+                                     subgraphs.end() );
+
+                    if( subgraphs.empty() )
+                        it = aCache.erase( it );
+                    else
+                        ++it;
+                }
+            };
+
+    m_subgraphs.erase( std::remove_if( m_subgraphs.begin(), m_subgraphs.end(), isAffected ),
+                       m_subgraphs.end() );
+    m_driver_subgraphs.erase( std::remove_if( m_driver_subgraphs.begin(),
+                                              m_driver_subgraphs.end(), isAffected ),
+                              m_driver_subgraphs.end() );
+
+    eraseAffected( m_net_name_to_subgraphs_map );
+    eraseAffected( m_global_label_cache );
+    eraseAffected( m_local_label_cache );
+    eraseAffected( m_net_code_to_subgraphs_map );
+    eraseAffected( m_link_key_map );
+
+    // The rebuilt invisible power pins are added back by the update
+    std::unordered_map<SCH_SHEET_PATH, std::unordered_set<SCH_ITEM*>> rebuilt_pins;
+
+    for( const auto& it : rebuild_items )
+    {
+        for( SCH_ITEM* item : it.second )
+        {
+            if( item->Type() == SCH_PIN_T )
+                rebuilt_pins[ it.first ].insert( item );
+        }
+    }
+
+    m_invisible_power_pins.erase(
+            std::remove_if( m_invisible_power_pins.begin(), m_invisible_power_pins.end(),
+                    [&]( const std::pair<SCH_SHEET_PATH, SCH_PIN*>& aPin )
+                    {
+                        return dead_items.count( aPin.second )
+                               || ( rebuilt_pins.count( aPin.first )
+                                    && rebuilt_pins.at( aPin.first ).count( aPin.second ) );
+                    } ),
+            m_invisible_power_pins.end() );
+
+    for( SCH_ITEM* item : dead_items )
+        m_items.erase( item );
+
+    for( CONNECTION_SUBGRAPH* subgraph : affected )
+        delete subgraph;
+
+    // Rebuild the affected part in a separate graph sharing our net and bus codes
+
+    CONNECTION_GRAPH update( m_schematic );
+
+    update.m_last_net_code = m_last_net_code;
+    update.m_last_bus_code = m_last_bus_code;
+    update.m_last_subgraph_code = m_last_subgraph_code;
+    std::swap( update.m_net_name_to_code_map, m_net_name_to_code_map );
+    std::swap( update.m_bus_name_to_code_map, m_bus_name_to_code_map );
+
+    for( const auto& it : rebuild_items )
+    {
+        const SCH_SHEET_PATH& sheet = it.first;
+        SCH_SCREEN*           screen = sheet.LastScreen();
+
+        update.updateItemConnectivity( sheet, it.second );
+
+        // UpdateDanglingState() also adds connected items for SCH_TEXT.  Only the rebuilt
+        // items can have changed, so there is no need to test the whole screen.
+        std::unordered_set<SCH_ITEM*> parents;
+
+        for( SCH_ITEM* item : it.second )
+        {
+            if( item->Type() == SCH_PIN_T )
+                parents.insert( static_cast<SCH_PIN*>( item )->GetParentComponent() );
+            else if( item->Type() == SCH_SHEET_PIN_T )
+                parents.insert( static_cast<SCH_SHEET_PIN*>( item )->GetParent() );
+            else
+                parents.insert( item );
+        }
+
+        for( SCH_ITEM* parent : parents )
+        {
+            std::vector<DANGLING_END_ITEM> endPoints;
+            EDA_RECT                       box = parent->GetBoundingBox();
+
+            box.Inflate( 1 );
+
+            for( SCH_ITEM* item : screen->Items().Overlapping( box ) )
+                item->GetEndPoints( endPoints );
+
+            parent->UpdateDanglingState( endPoints, &sheet );
+        }
+    }
+
+    update.buildConnectionGraph();
+
+    mergeGraph( update );
+
+    for( SCH_ITEM* item : dirty_screen_items )
+        item->SetConnectivityDirty( false );
+
+    for( SCH_ITEM* item : dirty_items )
+        item->SetConnectivityDirty( false );
+
+    recalc_dirty.Stop();
+    wxLogTrace( "CONN_PROFILE", "recalculateDirty() rebuilt %lu subgraphs in %0.4f ms",
+                static_cast<unsigned long>( affected.size() ), recalc_dirty.msecs() );
+
+    return true;
+}
+
+
+void CONNECTION_GRAPH::mergeGraph( CONNECTION_GRAPH& aGraph )
+{
+    std::function<void( SCH_CONNECTION* )> adopt =
+            [&]( SCH_CONNECTION* aConnection )
+            {
+                aConnection->SetGraph( this );
+
+                for( const auto& member : aConnection->Members() )
+                    adopt( member.get() );
+            };
+
+    m_last_net_code = aGraph.m_last_net_code;
+    m_last_bus_code = aGraph.m_last_bus_code;
+    m_last_subgraph_code = aGraph.m_last_subgraph_code;
+    std::swap( m_net_name_to_code_map, aGraph.m_net_name_to_code_map );
+    std::swap( m_bus_name_to_code_map, aGraph.m_bus_name_to_code_map );
+
+    for( SCH_ITEM* item : aGraph.m_items )
+    {
+        for( const auto& it : item->m_connection_map )
+            adopt( it.second );
+
+        m_items.insert( item );
+    }
+
+    for( CONNECTION_SUBGRAPH* subgraph : aGraph.m_subgraphs )
+    {
+        subgraph->m_graph = this;
+
+        for( const auto& it : subgraph->m_bus_neighbors )
+            adopt( it.first.get() );
+
+        for( const auto& it : subgraph->m_bus_parents )
+            adopt( it.first.get() );
+
+        m_subgraphs.push_back( subgraph );
+    }
+
+    m_driver_subgraphs.insert( m_driver_subgraphs.end(), aGraph.m_driver_subgraphs.begin(),
+                               aGraph.m_driver_subgraphs.end() );
+
+    m_invisible_power_pins.insert( m_invisible_power_pins.end(),
+                                   aGraph.m_invisible_power_pins.begin(),
+                                   aGraph.m_invisible_power_pins.end() );
+
+    auto mergeCache =
+            []( auto& aCache, const auto& aOther )
+            {
+                for( const auto& it : aOther )
+                {
+                    auto& subgraphs = aCache[ it.first ];
+                    subgraphs.insert( subgraphs.end(), it.second.begin(), it.second.end() );
+                }
+            };
+
+    mergeCache( m_net_name_to_subgraphs_map, aGraph.m_net_name_to_subgraphs_map );
+    mergeCache( m_global_label_cache, aGraph.m_global_label_cache );
+    mergeCache( m_local_label_cache, aGraph.m_local_label_cache );
+    mergeCache( m_net_code_to_subgraphs_map, aGraph.m_net_code_to_subgraphs_map );
+    mergeCache( m_link_key_map, aGraph.m_link_key_map );
+
+    m_sheet_to_subgraphs_map.clear();
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+        m_sheet_to_subgraphs_map[ subgraph->m_sheet ].emplace_back( subgraph );
+
+    // The subgraphs belong to this graph now
+    aGraph.m_subgraphs.clear();
+    aGraph.Reset();
+}
+
+
 void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                                                const std::vector<SCH_ITEM*>& aItemList )
 {
@@ -428,26 +1113,21 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
     for( SCH_ITEM* item : aItemList )
     {
         std::vector< wxPoint > points;
-        item->GetConnectionPoints( points );
+        getConnectionPoints( item, points );
         item->ConnectedItems( aSheet ).clear();
 
-        if( item->Type() == SCH_SHEET_T )
+        if( item->Type() == SCH_SHEET_PIN_T )
         {
-            for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
-            {
-                if( !pin->Connection( aSheet ) )
-                    pin->InitializeConnection( aSheet )->SetGraph( this );
+            SCH_SHEET_PIN* pin = static_cast<SCH_SHEET_PIN*>( item );
 
-                pin->ConnectedItems( aSheet ).clear();
-                pin->Connection( aSheet )->Reset();
+            if( !pin->Connection( aSheet ) )
+                pin->InitializeConnection( aSheet )->SetGraph( this );
 
-                connection_map[ pin->GetTextPos() ].push_back( pin );
-                m_items.insert( pin );
-            }
+            pin->Connection( aSheet )->Reset();
         }
-        else if( item->Type() == SCH_COMPONENT_T )
+        else if( item->Type() == SCH_PIN_T )
         {
-            SCH_COMPONENT* component = static_cast<SCH_COMPONENT*>( item );
+            SCH_PIN* pin = static_cast<SCH_PIN*>( item );
 
             // TODO(JE) right now this relies on GetSchPins() returning good SCH_PIN pointers
             // that contain good LIB_PIN pointers.  Since these get invalidated whenever the
@@ -456,28 +1136,18 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
             // connectivity calculations.  This is slow and should be improved before release.
             // See https://gitlab.com/kicad/code/kicad/issues/3784
 
-            for( SCH_PIN* pin : component->GetSchPins( &aSheet ) )
-            {
-                pin->InitializeConnection( aSheet )->SetGraph( this );
+            pin->InitializeConnection( aSheet )->SetGraph( this );
 
-                wxPoint pos = pin->GetPosition();
+            // because calling the first time is not thread-safe
+            pin->GetDefaultNetName( aSheet );
 
-                // because calling the first time is not thread-safe
-                pin->GetDefaultNetName( aSheet );
-                pin->ConnectedItems( aSheet ).clear();
+            // Invisible power pins need to be post-processed later
 
-                // Invisible power pins need to be post-processed later
-
-                if( pin->IsPowerConnection() && !pin->IsVisible() )
-                    m_invisible_power_pins.emplace_back( std::make_pair( aSheet, pin ) );
-
-                connection_map[ pos ].push_back( pin );
-                m_items.insert( pin );
-            }
+            if( pin->IsPowerConnection() && !pin->IsVisible() )
+                m_invisible_power_pins.emplace_back( std::make_pair( aSheet, pin ) );
         }
         else
         {
-            m_items.insert( item );
             auto conn = item->InitializeConnection( aSheet );
             conn->SetGraph( this );
 
@@ -496,10 +1166,6 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
                 static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
                 break;
 
-            case SCH_PIN_T:
-                conn->SetType( CONNECTION_TYPE::NET );
-                break;
-
             case SCH_BUS_WIRE_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::NET );
                 // clean previous (old) link:
@@ -509,12 +1175,12 @@ void CONNECTION_GRAPH::updateItemConnectivity( SCH_SHEET_PATH aSheet,
             default:
                 break;
             }
-
-            for( const wxPoint& point : points )
-                connection_map[ point ].push_back( item );
         }
 
-        item->SetConnectivityDirty( false );
+        for( const wxPoint& point : points )
+            connection_map[ point ].push_back( item );
+
+        m_items.insert( item );
     }
 
     for( const auto& it : connection_map )
@@ -1435,6 +2101,60 @@ void CONNECTION_GRAPH::buildConnectionGraph()
         m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
     }
 
+    // The caches and the links between subgraphs can still point to absorbed subgraphs.
+    // Point them to the subgraphs that absorbed them before these are deleted below.
+    auto absorber =
+            []( const CONNECTION_SUBGRAPH* aSubgraph ) -> CONNECTION_SUBGRAPH*
+            {
+                while( aSubgraph && aSubgraph->m_absorbed )
+                    aSubgraph = aSubgraph->m_absorbed_by;
+
+                return const_cast<CONNECTION_SUBGRAPH*>( aSubgraph );
+            };
+
+    for( auto& it : m_net_name_to_subgraphs_map )
+    {
+        for( CONNECTION_SUBGRAPH*& sg : it.second )
+            sg = absorber( sg );
+    }
+
+    for( auto& it : m_global_label_cache )
+    {
+        for( const CONNECTION_SUBGRAPH*& sg : it.second )
+            sg = absorber( sg );
+    }
+
+    for( auto& it : m_local_label_cache )
+    {
+        for( const CONNECTION_SUBGRAPH*& sg : it.second )
+            sg = absorber( sg );
+    }
+
+    auto remapLinks =
+            [&]( std::unordered_map< std::shared_ptr<SCH_CONNECTION>,
+                                     std::unordered_set<CONNECTION_SUBGRAPH*> >& aLinks )
+            {
+                for( auto& it : aLinks )
+                {
+                    std::unordered_set<CONNECTION_SUBGRAPH*> remapped;
+
+                    for( CONNECTION_SUBGRAPH* sg : it.second )
+                        remapped.insert( absorber( sg ) );
+
+                    it.second = std::move( remapped );
+                }
+            };
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+    {
+        if( subgraph->m_absorbed )
+            continue;
+
+        remapLinks( subgraph->m_bus_neighbors );
+        remapLinks( subgraph->m_bus_parents );
+        subgraph->m_hier_parent = absorber( subgraph->m_hier_parent );
+    }
+
     // Clean up and deallocate stale subgraphs
     m_subgraphs.erase( std::remove_if( m_subgraphs.begin(), m_subgraphs.end(),
             [&]( const CONNECTION_SUBGRAPH* sg )
@@ -1450,6 +2170,9 @@ void CONNECTION_GRAPH::buildConnectionGraph()
                 }
             } ),
             m_subgraphs.end() );
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+        cacheLinkKeys( subgraph );
 }
 
 
@@ -206,6 +206,13 @@ public:
 
     // If not null, this indicates the subgraph on a higher level sheet that is linked to this one
     CONNECTION_SUBGRAPH* m_hier_parent;
+
+    /**
+     * The names through which this subgraph can be linked to subgraphs it doesn't touch
+     * (labels, power pins, hierarchical links, bus members and its final net name).  Used to
+     * find which subgraphs must be rebuilt together when only some items have changed.
+     */
+    std::vector<wxString> m_link_keys;
 };
 
 /// Associates a net code with the final name of a net
@@ -242,7 +249,14 @@ public:
     /**
      * Updates the connection graph for the given list of sheets.
      *
-     * @param aSheetList is the list of possibly modified sheets
+     * Unless aUnconditional is set, only the subgraphs touching items marked with
+     * SetConnectivityDirty() (or removed since the last update) are rebuilt, together with
+     * the subgraphs they are linked to by name, by bus membership or through the hierarchy.
+     * Changes that can rename nets all over the hierarchy (sheet edits), schematics using
+     * bus aliases and changes touching most of the graph still fall back to a full
+     * recalculation.
+     *
+     * @param aSheetList is the list of all the sheets of the schematic
      * @param aUnconditional is true if an unconditional full recalculation should be done
      */
     void Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnconditional = false );
@@ -310,6 +324,9 @@ private:
 
     NET_MAP m_net_code_to_subgraphs_map;
 
+    /// Lookup of the subgraphs by their link keys, see CONNECTION_SUBGRAPH::m_link_keys
+    std::unordered_map<wxString, std::vector<CONNECTION_SUBGRAPH*>> m_link_key_map;
+
     int m_last_net_code;
 
     int m_last_bus_code;
@@ -318,6 +335,57 @@ private:
 
     SCHEMATIC* m_schematic;     ///< The schematic this graph represents
 
+    /**
+     * Rebuilds only the part of the graph affected by the dirty and removed items.
+     *
+     * The affected subgraphs are found from the dirty items, the items they now touch and
+     * the link keys of the subgraphs, then they are removed from the graph and rebuilt by
+     * running buildConnectionGraph() on their items only, in a temporary graph that shares
+     * the net and bus codes of this one.  The result is merged back into this graph.
+     *
+     * @param aSheetList is the list of all the sheets of the schematic
+     * @return false if nothing was changed and a full recalculation is needed instead
+     */
+    bool recalculateDirty( const SCH_SHEET_LIST& aSheetList );
+
+    /**
+     * Moves the subgraphs, items and caches of a graph built by recalculateDirty() into
+     * this one.  aGraph is left empty.
+     */
+    void mergeGraph( CONNECTION_GRAPH& aGraph );
+
+    /**
+     * Computes the link keys of a subgraph and adds it to m_link_key_map.
+     */
+    void cacheLinkKeys( CONNECTION_SUBGRAPH* aSubgraph );
+
+    /**
+     * Appends the link keys of the driver names of an item, as they are in the schematic now.
+     */
+    void getLinkKeys( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet,
+                      std::vector<wxString>& aKeys );
+
+    /**
+     * Appends the items of the graph on aSheet that share a connection point with aItem,
+     * or that have a connection point in the middle of aItem (or aItem in the middle of
+     * them) as labels and bus entries can.
+     */
+    void getTouchingItems( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem,
+                           std::vector<SCH_ITEM*>& aItems );
+
+    /**
+     * Appends the items of the graph standing for a schematic item: the pins of a symbol or
+     * of a sheet, or the item itself.
+     */
+    static void getConnectableItems( const SCH_SHEET_PATH& aSheet, SCH_ITEM* aItem,
+                                     std::vector<SCH_ITEM*>& aItems );
+
+    /**
+     * Appends the points where an item of the graph (as returned by getConnectableItems())
+     * connects to other items.
+     */
+    static void getConnectionPoints( SCH_ITEM* aItem, std::vector<wxPoint>& aPoints );
+
     /**
      * Updates the graphical connectivity between items (i.e. where they touch)
      * The items passed in must be on the same sheet.
@@ -330,10 +398,8 @@ private:
      *
      * Any item that is stored in the list of items that have a connection point
      * at a given (x, y) location will eventually be electrically connected.
-     * This means that we can't store SCH_COMPONENTs in this map -- we must store
-     * a structure that links a specific pin on a component back to that
-     * component: a SCH_PIN_CONNECTION.  This wrapper class is a convenience for
-     * linking a pin and component to a specific (x, y) point.
+     * This means that we can't store SCH_COMPONENTs in this map -- the list holds
+     * the pins of components and sheets instead, see getConnectableItems().
      *
      * In the second phase, we iterate over each value in the map, which is a
      * vector of items that have overlapping connection points.  After some
@@ -343,7 +409,7 @@ private:
      * As a side effect, items are loaded into m_items for BuildConnectionGraph()
      *
      * @param aSheet is the path to the sheet of all items in the list
-     * @param aItemList is a list of items to consider
+     * @param aItemList is a list of connectable items, as returned by getConnectableItems()
      */
     void updateItemConnectivity( SCH_SHEET_PATH aSheet,
                                  const std::vector<SCH_ITEM*>& aItemList );
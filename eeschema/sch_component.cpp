@@ -166,6 +166,7 @@ SCH_COMPONENT::SCH_COMPONENT( const SCH_COMPONENT& aComponent ) :
     m_convert     = aComponent.m_convert;
     m_lib_id      = aComponent.m_lib_id;
     m_isInNetlist = aComponent.m_isInNetlist;
+    m_orientedPartSource = nullptr;
 
     if( aComponent.m_part )
         SetLibSymbol( new LIB_PART( *aComponent.m_part.get() ) );
@@ -187,6 +188,7 @@ SCH_COMPONENT::SCH_COMPONENT( const SCH_COMPONENT& aComponent ) :
 
 void SCH_COMPONENT::Init( const wxPoint& pos )
 {
+    m_orientedPartSource = nullptr;
     m_Pos     = pos;
     m_unit    = 1;  // In multi unit chip - which unit to draw.
     m_convert = LIB_ITEM::LIB_CONVERT::BASE;  // De Morgan Handling
@@ -251,10 +253,84 @@ void SCH_COMPONENT::SetLibSymbol( LIB_PART* aLibSymbol )
     wxCHECK2( ( aLibSymbol == nullptr ) || ( aLibSymbol->IsRoot() ), aLibSymbol = nullptr );
 
     m_part.reset( aLibSymbol );
+    m_orientedPart.reset();
+    m_orientedPartSource = nullptr;
     UpdatePins();
 }
 
 
+/**
+ * Rotate and mirror the items of \a aPart, around the library origin, to \a aOrientation.
+ */
+static void orientPart( LIB_PART* aPart, int aOrientation )
+{
+    struct ORIENT
+    {
+        int flag;
+        int n_rots;
+        int mirror_x;
+        int mirror_y;
+    }
+    orientations[] =
+    {
+        { CMP_ORIENT_0,                  0, 0, 0 },
+        { CMP_ORIENT_90,                 1, 0, 0 },
+        { CMP_ORIENT_180,                2, 0, 0 },
+        { CMP_ORIENT_270,                3, 0, 0 },
+        { CMP_MIRROR_X + CMP_ORIENT_0,   0, 1, 0 },
+        { CMP_MIRROR_X + CMP_ORIENT_90,  1, 1, 0 },
+        { CMP_MIRROR_Y,                  0, 0, 1 },
+        { CMP_MIRROR_X + CMP_ORIENT_270, 3, 1, 0 },
+        { CMP_MIRROR_Y + CMP_ORIENT_0,   0, 0, 1 },
+        { CMP_MIRROR_Y + CMP_ORIENT_90,  1, 0, 1 },
+        { CMP_MIRROR_Y + CMP_ORIENT_180, 2, 0, 1 },
+        { CMP_MIRROR_Y + CMP_ORIENT_270, 3, 0, 1 }
+    };
+
+    ORIENT o = orientations[ 0 ];
+
+    for( auto& i : orientations )
+    {
+        if( i.flag == aOrientation )
+        {
+            o = i;
+            break;
+        }
+    }
+
+    for( auto& item : aPart->GetDrawItems() )
+    {
+        for( int i = 0; i < o.n_rots; i++ )
+            item.Rotate( wxPoint(0, 0 ), true );
+
+        if( o.mirror_x )
+            item.MirrorVertical( wxPoint( 0, 0 ) );
+
+        if( o.mirror_y )
+            item.MirrorHorizontal( wxPoint( 0, 0 ) );
+    }
+}
+
+
+LIB_PART* SCH_COMPONENT::GetOrientedPart()
+{
+    // Use dummy part if the actual couldn't be found (or couldn't be locked).
+    const LIB_PART* source = m_part ? m_part.get() : dummy();
+
+    if( !m_orientedPart || m_orientedPartSource != source
+            || m_orientedPartTransform != m_transform )
+    {
+        m_orientedPart.reset( new LIB_PART( *source ) );
+        orientPart( m_orientedPart.get(), GetOrientation() );
+
+        m_orientedPartSource = source;
+        m_orientedPartTransform = m_transform;
+    }
+
+    return m_orientedPart.get();
+}
+
+
 wxString SCH_COMPONENT::GetDescription() const
 {
     if( m_part )
@@ -761,6 +837,11 @@ void SCH_COMPONENT::SwapData( SCH_ITEM* aItem )
     m_part.reset( part );
     UpdatePins();
 
+    // The oriented copies follow their source symbols, which have just been swapped
+    m_orientedPart.swap( component->m_orientedPart );
+    std::swap( m_orientedPartSource, component->m_orientedPartSource );
+    std::swap( m_orientedPartTransform, component->m_orientedPartTransform );
+
     std::swap( m_Pos, component->m_Pos );
     std::swap( m_unit, component->m_unit );
     std::swap( m_convert, component->m_convert );
@@ -1619,6 +1700,8 @@ SCH_COMPONENT& SCH_COMPONENT::operator=( const SCH_ITEM& aItem )
         LIB_PART* libSymbol = c->m_part ? new LIB_PART( *c->m_part.get() ) : nullptr;
 
         m_part.reset( libSymbol );
+        m_orientedPart.reset();
+        m_orientedPartSource = nullptr;
         m_Pos       = c->m_Pos;
         m_unit      = c->m_unit;
         m_convert   = c->m_convert;
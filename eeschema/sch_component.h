@@ -121,6 +121,12 @@ private:
     ///< A flattened copy of a LIB_PART found in the PROJECT's libraries to for this component.
     std::unique_ptr< LIB_PART > m_part;
 
+    ///< A copy of m_part (or of the dummy symbol) rotated and mirrored to the component
+    ///< orientation, kept for drawing until the symbol or the orientation changes.
+    std::unique_ptr< LIB_PART > m_orientedPart;
+    const LIB_PART*             m_orientedPartSource;
+    TRANSFORM                   m_orientedPartTransform;
+
     SCH_PINS    m_pins;         ///< a SCH_PIN for every LIB_PIN (across all units)
     SCH_PIN_MAP m_pinMap;       ///< the component's pins mapped by LIB_PIN*
 
@@ -220,6 +226,16 @@ public:
 
     std::unique_ptr< LIB_PART >& GetPartRef() { return m_part; }
 
+    /**
+     * Return the library symbol rotated and mirrored to the orientation of the component,
+     * at the library origin.  A dummy symbol is returned if the library symbol is missing.
+     *
+     * The copy is built on the first call and reused until the library symbol or the
+     * orientation changes, so drawing does not copy the symbol on every redraw.  Its items
+     * carry no state of this component: the painter sets the flags it needs before drawing.
+     */
+    LIB_PART* GetOrientedPart();
+
     /**
      * Set this schematic symbol library symbol reference to \a aLibSymbol
      *
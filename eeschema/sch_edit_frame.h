@@ -967,8 +967,11 @@ public:
 
     /**
      * Generates the connection data for the entire schematic hierarchy.
+     *
+     * @param aIncremental only updates the connections of the items changed since the last
+     *                     update when possible, see CONNECTION_GRAPH::Recalculate()
      */
-    void RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags );
+    void RecalculateConnections( SCH_CLEANUP_FLAGS aCleanupFlags, bool aIncremental = false );
 
     /**
      * Allows Eeschema to install its preferences panels into the preferences dialog.
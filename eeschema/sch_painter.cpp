@@ -112,45 +112,6 @@ EESCHEMA_SETTINGS* eeconfig()
 }
 
 
-/**
- * Used when a LIB_PART is not found in library to draw a dummy shape.
- * This component is a 400 mils square with the text "??"
- *
- *   DEF DUMMY U 0 40 Y Y 1 0 N
- *     F0 "U" 0 -350 60 H V
- *     F1 "DUMMY" 0 350 60 H V
- *     DRAW
- *       T 0 0 0 150 0 0 0 ??
- *       S -200 200 200 -200 0 1 0
- *     ENDDRAW
- *   ENDDEF
- */
-static LIB_PART* dummy()
-{
-    static LIB_PART* part;
-
-    if( !part )
-    {
-        part = new LIB_PART( wxEmptyString );
-
-        LIB_RECTANGLE* square = new LIB_RECTANGLE( part );
-
-        square->MoveTo( wxPoint( Mils2iu( -200 ), Mils2iu( 200 ) ) );
-        square->SetEndPosition( wxPoint( Mils2iu( 200 ), Mils2iu( -200 ) ) );
-
-        LIB_TEXT* text = new LIB_TEXT( part );
-
-        text->SetTextSize( wxSize( Mils2iu( 150 ), Mils2iu( 150 ) ) );
-        text->SetText( wxString( wxT( "??" ) ) );
-
-        part->AddDrawItem( square );
-        part->AddDrawItem( text );
-    }
-
-    return part;
-}
-
-
 SCH_PAINTER::SCH_PAINTER( GAL* aGal ) :
     KIGFX::PAINTER( aGal ),
     m_schematic( nullptr )
@@ -1339,92 +1300,47 @@ void SCH_PAINTER::draw( SCH_TEXT *aText, int aLayer )
 }
 
 
-static void orientPart( LIB_PART* part, int orientation )
-{
-    struct ORIENT
-    {
-        int flag;
-        int n_rots;
-        int mirror_x;
-        int mirror_y;
-    }
-    orientations[] =
-    {
-        { CMP_ORIENT_0,                  0, 0, 0 },
-        { CMP_ORIENT_90,                 1, 0, 0 },
-        { CMP_ORIENT_180,                2, 0, 0 },
-        { CMP_ORIENT_270,                3, 0, 0 },
-        { CMP_MIRROR_X + CMP_ORIENT_0,   0, 1, 0 },
-        { CMP_MIRROR_X + CMP_ORIENT_90,  1, 1, 0 },
-        { CMP_MIRROR_Y,                  0, 0, 1 },
-        { CMP_MIRROR_X + CMP_ORIENT_270, 3, 1, 0 },
-        { CMP_MIRROR_Y + CMP_ORIENT_0,   0, 0, 1 },
-        { CMP_MIRROR_Y + CMP_ORIENT_90,  1, 0, 1 },
-        { CMP_MIRROR_Y + CMP_ORIENT_180, 2, 0, 1 },
-        { CMP_MIRROR_Y + CMP_ORIENT_270, 3, 0, 1 }
-    };
-
-    ORIENT o = orientations[ 0 ];
-
-    for( auto& i : orientations )
-    {
-        if( i.flag == orientation )
-        {
-            o = i;
-            break;
-        }
-    }
-
-    for( auto& item : part->GetDrawItems() )
-    {
-        for( int i = 0; i < o.n_rots; i++ )
-            item.Rotate( wxPoint(0, 0 ), true );
-
-        if( o.mirror_x )
-            item.MirrorVertical( wxPoint( 0, 0 ) );
-
-        if( o.mirror_y )
-            item.MirrorHorizontal( wxPoint( 0, 0 ) );
-    }
-}
-
-
 void SCH_PAINTER::draw( SCH_COMPONENT *aComp, int aLayer )
 {
-    // Use dummy part if the actual couldn't be found (or couldn't be locked).
-    LIB_PART* originalPart = aComp->GetPartRef() ? aComp->GetPartRef().get() : dummy();
-
-    // Copy the source so we can re-orient and translate it.
-    LIB_PART tempPart( *originalPart );
-
-    tempPart.SetFlags( aComp->GetFlags() );
+    // The oriented symbol is kept by the component, so nothing is copied here: the
+    // component state is set on its items and its position is applied by the GAL.
+    LIB_PART* orientedPart = aComp->GetOrientedPart();
 
-    orientPart( &tempPart, aComp->GetOrientation() );
+    orientedPart->ClearFlags();
+    orientedPart->SetFlags( aComp->GetFlags() );
 
-    for( auto& tempItem : tempPart.GetDrawItems() )
+    for( auto& item : orientedPart->GetDrawItems() )
     {
-        tempItem.SetFlags( aComp->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
-        tempItem.MoveTo( tempItem.GetPosition() + (wxPoint) mapCoords( aComp->GetPosition() ) );
+        item.ClearFlags();
+        item.SetFlags( aComp->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
     }
 
-    // Copy the pin info from the component to the temp pins
-    LIB_PINS tempPins;
-    tempPart.GetPins( tempPins, aComp->GetUnit(), aComp->GetConvert() );
+    // Copy the pin info from the component to the oriented pins
+    LIB_PINS orientedPins;
+    orientedPart->GetPins( orientedPins, aComp->GetUnit(), aComp->GetConvert() );
     const SCH_PIN_PTRS compPins = aComp->GetSchPins();
 
-    for( unsigned i = 0; i < tempPins.size() && i < compPins.size(); ++ i )
+    for( unsigned i = 0; i < orientedPins.size() && i < compPins.size(); ++ i )
     {
-        LIB_PIN* tempPin = tempPins[ i ];
+        LIB_PIN* orientedPin = orientedPins[ i ];
         const SCH_PIN* compPin = compPins[ i ];
 
-        tempPin->ClearFlags();
-        tempPin->SetFlags( compPin->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
+        orientedPin->ClearFlags();
+        orientedPin->SetFlags( compPin->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED
 
         if( compPin->IsDangling() )
-            tempPin->SetFlags( IS_DANGLING );
+            orientedPin->SetFlags( IS_DANGLING );
     }
 
-    draw( &tempPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+    // The library items are drawn relative to the component position.  As mapCoords()
+    // flips the Y axis of library coordinates, the translation is the component position
+    // itself.
+    m_gal->Save();
+    m_gal->Translate( VECTOR2D( aComp->GetPosition() ) );
+
+    draw( orientedPart, aLayer, false, aComp->GetUnit(), aComp->GetConvert() );
+
+    m_gal->Restore();
 
     // The fields are SCH_COMPONENT-specific so don't need to be copied/oriented/translated
     for( SCH_FIELD& field : aComp->GetFields() )
@@ -43,6 +43,29 @@ using namespace std;
 
 static const wxChar* const traceNgspice = wxT( "KICAD_NGSPICE" );
 
+
+/**
+ * Returns the name under which ngspice streams a vector requested in Spice convention:
+ * node voltages are named after the node only and branch currents get a "#branch" suffix.
+ * Device parameters (e.g. @r1[i]) keep their name.
+ * @param aName is the lowercase vector name.
+ */
+static string streamedVectorName( const string& aName )
+{
+    if( aName.size() > 3 && aName.back() == ')' )
+    {
+        string inner = aName.substr( 2, aName.size() - 3 );
+
+        if( aName.compare( 0, 2, "v(" ) == 0 )
+            return inner;
+
+        if( aName.compare( 0, 2, "i(" ) == 0 )
+            return inner + "#branch";
+    }
+
+    return aName;
+}
+
 NGSPICE::NGSPICE()
         : m_ngSpice_Init( nullptr ),
           m_ngSpice_Circ( nullptr ),
@@ -52,7 +75,8 @@ NGSPICE::NGSPICE()
           m_ngSpice_AllPlots( nullptr ),
           m_ngSpice_AllVecs( nullptr ),
           m_ngSpice_Running( nullptr ),
-          m_error( false )
+          m_error( false ),
+          m_streaming( false )
 {
     init_dll();
 }
@@ -91,28 +115,41 @@ vector<string> NGSPICE::AllPlots()
 }
 
 
-vector<COMPLEX> NGSPICE::GetPlot( const string& aName, int aMaxLen )
+SPICE_VECTOR NGSPICE::GetVector( const string& aName )
 {
+    static_assert( sizeof( ngcomplex_t ) == 2 * sizeof( double ),
+                   "ngspice complex values are expected to be pairs of doubles" );
+
     LOCALE_IO c_locale;       // ngspice works correctly only with C locale
-    vector<COMPLEX> data;
     vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
 
-    if( vi )
-    {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
-        data.reserve( length );
+    if( !vi || vi->v_length <= 0 )
+        return SPICE_VECTOR();
 
-        if( vi->v_realdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.emplace_back( vi->v_realdata[i], 0.0 );
-        }
-        else if( vi->v_compdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.emplace_back( vi->v_compdata[i].cx_real, vi->v_compdata[i].cx_imag );
-        }
-    }
+    return SPICE_VECTOR( vi->v_realdata, reinterpret_cast<const double*>( vi->v_compdata ),
+                         vi->v_length );
+}
+
+
+/**
+ * Number of values to read from a vector, limited to aMaxLen if it is not negative.
+ */
+static size_t plotLength( const SPICE_VECTOR& aVector, int aMaxLen )
+{
+    return aMaxLen < 0 ? aVector.size() : std::min<size_t>( aMaxLen, aVector.size() );
+}
+
+
+vector<COMPLEX> NGSPICE::GetPlot( const string& aName, int aMaxLen )
+{
+    SPICE_VECTOR    vec = GetVector( aName );
+    size_t          length = plotLength( vec, aMaxLen );
+    vector<COMPLEX> data;
+
+    data.reserve( length );
+
+    for( size_t i = 0; i < length; i++ )
+        data.emplace_back( vec.Real( i ), vec.Imag( i ) );
 
     return data;
 }
@@ -120,30 +157,16 @@ vector<COMPLEX> NGSPICE::GetPlot( const string& aName, int aMaxLen )
 
 vector<double> NGSPICE::GetRealPlot( const string& aName, int aMaxLen )
 {
-    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    SPICE_VECTOR   vec = GetVector( aName );
+    size_t         length = plotLength( vec, aMaxLen );
     vector<double> data;
-    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
 
-    if( vi )
-    {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
-        data.reserve( length );
+    data.reserve( length );
 
-        if( vi->v_realdata )
-        {
-            for( int i = 0; i < length; i++ )
-            {
-                data.push_back( vi->v_realdata[i] );
-            }
-        }
-        else if( vi->v_compdata )
-        {
-            for( int i = 0; i < length; i++ )
-            {
-                assert( vi->v_compdata[i].cx_imag == 0.0 );
-                data.push_back( vi->v_compdata[i].cx_real );
-            }
-        }
+    for( size_t i = 0; i < length; i++ )
+    {
+        assert( vec.Imag( i ) == 0.0 );
+        data.push_back( vec.Real( i ) );
     }
 
     return data;
@@ -152,23 +175,17 @@ vector<double> NGSPICE::GetRealPlot( const string& aName, int aMaxLen )
 
 vector<double> NGSPICE::GetImagPlot( const string& aName, int aMaxLen )
 {
-    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    SPICE_VECTOR   vec = GetVector( aName );
     vector<double> data;
-    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
 
-    if( vi )
-    {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
-        data.reserve( length );
+    if( !vec.IsComplex() )
+        return data;
 
-        if( vi->v_compdata )
-        {
-            for( int i = 0; i < length; i++ )
-            {
-                data.push_back( vi->v_compdata[i].cx_imag );
-            }
-        }
-    }
+    size_t length = plotLength( vec, aMaxLen );
+    data.reserve( length );
+
+    for( size_t i = 0; i < length; i++ )
+        data.push_back( vec.Imag( i ) );
 
     return data;
 }
@@ -176,26 +193,14 @@ vector<double> NGSPICE::GetImagPlot( const string& aName, int aMaxLen )
 
 vector<double> NGSPICE::GetMagPlot( const string& aName, int aMaxLen )
 {
-    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    SPICE_VECTOR   vec = GetVector( aName );
+    size_t         length = plotLength( vec, aMaxLen );
     vector<double> data;
-    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
 
-    if( vi )
-    {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
-        data.reserve( length );
+    data.reserve( length );
 
-        if( vi->v_realdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.push_back( vi->v_realdata[i] );
-        }
-        else if( vi->v_compdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.push_back( hypot( vi->v_compdata[i].cx_real, vi->v_compdata[i].cx_imag ) );
-        }
-    }
+    for( size_t i = 0; i < length; i++ )
+        data.push_back( vec.Mag( i ) );
 
     return data;
 }
@@ -203,28 +208,64 @@ vector<double> NGSPICE::GetMagPlot( const string& aName, int aMaxLen )
 
 vector<double> NGSPICE::GetPhasePlot( const string& aName, int aMaxLen )
 {
-    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    SPICE_VECTOR   vec = GetVector( aName );
+    size_t         length = plotLength( vec, aMaxLen );
     vector<double> data;
-    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
 
-    if( vi )
+    data.reserve( length );
+
+    for( size_t i = 0; i < length; i++ )
+        data.push_back( vec.Phase( i ) );    // 0 for real vectors, well, that's life
+
+    return data;
+}
+
+
+void NGSPICE::EnableStreaming( bool aEnable, const vector<string>& aVectors )
+{
+    std::lock_guard<std::mutex> lock( m_streamLock );
+
+    m_streaming = aEnable && !aVectors.empty();
+    m_streamNames.clear();
+    m_streamSlots.clear();
+    m_streamValues.clear();
+
+    if( !m_streaming )
+        return;
+
+    for( const string& vector : aVectors )
     {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
-        data.reserve( length );
+        string name( vector );
+        std::transform( name.begin(), name.end(), name.begin(), ::tolower );
 
-        if( vi->v_realdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.push_back( 0.0 );      // well, that's life
-        }
-        else if( vi->v_compdata )
-        {
-            for( int i = 0; i < length; i++ )
-                data.push_back( atan2( vi->v_compdata[i].cx_imag, vi->v_compdata[i].cx_real ) );
-        }
+        if( std::find( m_streamNames.begin(), m_streamNames.end(), name ) == m_streamNames.end() )
+            m_streamNames.push_back( name );
     }
 
-    return data;
+    m_streamValues.resize( m_streamNames.size() );
+}
+
+
+bool NGSPICE::TakeNewPoints( std::map<string, vector<COMPLEX>>& aPoints )
+{
+    aPoints.clear();
+
+    std::lock_guard<std::mutex> lock( m_streamLock );
+
+    if( !m_streaming )
+        return false;
+
+    for( size_t i = 0; i < m_streamNames.size(); ++i )
+    {
+        if( m_streamValues[i].empty() )
+            continue;
+
+        vector<COMPLEX>& values = aPoints[ m_streamNames[i] ];
+        values.swap( m_streamValues[i] );
+        m_streamValues[i].reserve( values.size() );
+    }
+
+    return true;
 }
 
 
@@ -257,6 +298,16 @@ bool NGSPICE::LoadNetlist( const string& aNetlist )
 bool NGSPICE::Run()
 {
     LOCALE_IO c_locale;               // ngspice works correctly only with C locale
+
+    {
+        // Points streamed by a previous run are not a part of the new one
+        std::lock_guard<std::mutex> lock( m_streamLock );
+        m_streamSlots.clear();
+
+        for( vector<COMPLEX>& values : m_streamValues )
+            values.clear();
+    }
+
     return Command( "bg_run" );     // bg_* commands execute in a separate thread
 }
 
@@ -391,7 +442,8 @@ void NGSPICE::init_dll()
     m_ngSpice_AllVecs = (ngSpice_AllVecs) m_dll.GetSymbol( "ngSpice_AllVecs" );
     m_ngSpice_Running = (ngSpice_Running) m_dll.GetSymbol( "ngSpice_running" ); // it is not a typo
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, NULL, NULL, &cbBGThreadRunning, this );
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, NULL,
+                    &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
     // Switch to the executable directory, so the relative paths are correct
@@ -541,6 +593,54 @@ int NGSPICE::cbSendStat( char* what, int id, void* user )
 }
 
 
+int NGSPICE::cbSendData( pvecvaluesall aValues, int aCount, int id, void* user )
+{
+    // Called from the background thread for every computed point, the vectors of the plot
+    // are being reallocated so the values are only read from the callback arguments
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+
+    std::lock_guard<std::mutex> lock( sim->m_streamLock );
+
+    if( !sim->m_streaming || !aValues )
+        return 0;
+
+    size_t count = std::max( aValues->veccount, 0 );
+
+    if( sim->m_streamSlots.size() != count )
+    {
+        sim->m_streamSlots.assign( count, -1 );
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            string name( aValues->vecsa[i]->name );
+            std::transform( name.begin(), name.end(), name.begin(), ::tolower );
+
+            for( size_t slot = 0; slot < sim->m_streamNames.size(); ++slot )
+            {
+                const string& requested = sim->m_streamNames[slot];
+
+                if( requested == name || streamedVectorName( requested ) == name )
+                {
+                    sim->m_streamSlots[i] = (int) slot;
+                    break;
+                }
+            }
+        }
+    }
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        if( sim->m_streamSlots[i] < 0 )
+            continue;
+
+        const vecvalues* value = aValues->vecsa[i];
+        sim->m_streamValues[ sim->m_streamSlots[i] ].emplace_back( value->creal, value->cimag );
+    }
+
+    return 0;
+}
+
+
 int NGSPICE::cbBGThreadRunning( bool is_running, int id, void* user )
 {
     NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
@@ -30,6 +30,8 @@
 #include <wx/dynlib.h>
 #include <ngspice/sharedspice.h>
 
+#include <mutex>
+
 class wxDynamicLibrary;
 
 class NGSPICE : public SPICE_SIMULATOR {
@@ -62,6 +64,15 @@ public:
     ///> @copydoc SPICE_SIMULATOR::AllPlots()
     std::vector<std::string> AllPlots() override;
 
+    ///> @copydoc SPICE_SIMULATOR::GetVector()
+    SPICE_VECTOR GetVector( const std::string& aName ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::EnableStreaming()
+    void EnableStreaming( bool aEnable, const std::vector<std::string>& aVectors = {} ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::TakeNewPoints()
+    bool TakeNewPoints( std::map<std::string, std::vector<COMPLEX>>& aPoints ) override;
+
     ///> @copydoc SPICE_SIMULATOR::GetPlot()
     std::vector<COMPLEX> GetPlot( const std::string& aName, int aMaxLen = -1 ) override;
 
@@ -122,6 +133,7 @@ private:
     // Callback functions
     static int cbSendChar( char* what, int id, void* user );
     static int cbSendStat( char* what, int id, void* user );
+    static int cbSendData( pvecvaluesall aValues, int aCount, int id, void* user );
     static int cbBGThreadRunning( bool is_running, int id, void* user );
     static int cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user );
 
@@ -136,6 +148,21 @@ private:
 
     ///> current netlist
     std::string m_netlist;
+
+    ///> Guards the streamed points, written by the ngspice background thread
+    std::mutex m_streamLock;
+
+    ///> Set to collect the points of the running simulation
+    bool m_streaming;
+
+    ///> Lowercase names of the vectors to stream, as requested with EnableStreaming()
+    std::vector<std::string> m_streamNames;
+
+    ///> For each vector of the running plot, its index in m_streamNames or -1 if not streamed
+    std::vector<int> m_streamSlots;
+
+    ///> Points computed since the last TakeNewPoints() call, one vector per name
+    std::vector<std::vector<COMPLEX>> m_streamValues;
 };
 
 #endif /* NGSPICE_H */
@@ -121,7 +121,8 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
         : SIM_PLOT_FRAME_BASE( aParent ),
           m_lastSimPlot( nullptr ),
           m_welcomePanel( nullptr ),
-          m_plotNumber( 0 )
+          m_plotNumber( 0 ),
+          m_livePlotStarted( false )
 {
     SetKiway( this, aKiway );
     m_signalsIconColorList = NULL;
@@ -172,6 +173,10 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Connect( EVT_SIM_FINISHED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimFinished ), NULL, this );
     Connect( EVT_SIM_CURSOR_UPDATE, wxCommandEventHandler( SIM_PLOT_FRAME::onCursorUpdate ), NULL, this );
 
+    m_livePlotTimer.SetOwner( this );
+    Connect( m_livePlotTimer.GetId(), wxEVT_TIMER,
+             wxTimerEventHandler( SIM_PLOT_FRAME::onLivePlotTimer ), NULL, this );
+
     // Toolbar buttons
     m_toolSimulate = m_toolBar->AddTool( ID_SIM_RUN, _( "Run/Stop Simulation" ),
             KiBitmap( sim_run_xpm ), _( "Run Simulation" ), wxITEM_NORMAL );
@@ -229,6 +234,7 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
 
 SIM_PLOT_FRAME::~SIM_PLOT_FRAME()
 {
+    m_livePlotTimer.Stop();
     m_simulator->SetReporter( nullptr );
     delete m_reporter;
     delete m_signalsIconColorList;
@@ -458,6 +464,7 @@ void SIM_PLOT_FRAME::StartSimulation( const wxString& aSimCommand )
     m_simulator->LoadNetlist( formatter.GetString() );
     updateTuners();
     applyTuners();
+    updateStreaming();
     m_simulator->Run();
 }
 
@@ -697,14 +704,15 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
     if( xAxisName.IsEmpty() )
         return false;
 
-    auto data_x = m_simulator->GetMagPlot( (const char*) xAxisName.c_str() );
-    unsigned int size = data_x.size();
+    // The vectors are read in place, the views stay valid as long as no command is sent
+    SPICE_VECTOR x_vector = m_simulator->GetVector( (const char*) xAxisName.c_str() );
+    size_t size = x_vector.size();
 
-    if( data_x.empty() )
+    if( x_vector.empty() )
         return false;
 
     SIM_PLOT_TYPE plotType = aDescriptor.GetType();
-    std::vector<double> data_y;
+    bool phase = false;
 
     // Now, Y axis data
     switch( m_exporter->GetSimType() )
@@ -714,31 +722,43 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
             wxASSERT_MSG( !( ( plotType & SPT_AC_MAG ) && ( plotType & SPT_AC_PHASE ) ),
                     "Cannot set both AC_PHASE and AC_MAG bits" );
 
-            if( plotType & SPT_AC_MAG )
-                data_y = m_simulator->GetMagPlot( (const char*) spiceVector.c_str() );
-            else if( plotType & SPT_AC_PHASE )
-                data_y = m_simulator->GetPhasePlot( (const char*) spiceVector.c_str() );
-            else
+            if( plotType & SPT_AC_PHASE )
+            {
+                phase = true;
+            }
+            else if( !( plotType & SPT_AC_MAG ) )
+            {
                 wxASSERT_MSG( false, "Plot type missing AC_PHASE or AC_MAG bit" );
+                return false;
+            }
         }
         break;
 
         case ST_NOISE:
         case ST_DC:
         case ST_TRANSIENT:
-        {
-            data_y = m_simulator->GetMagPlot( (const char*) spiceVector.c_str() );
-        }
-        break;
+            break;
 
         default:
             wxASSERT_MSG( false, "Unhandled plot type" );
             return false;
     }
 
-    if( data_y.size() != size )
+    SPICE_VECTOR y_vector = m_simulator->GetVector( (const char*) spiceVector.c_str() );
+
+    if( y_vector.size() != size )
         return false;
 
+    // The only copy of the values, it is moved to the trace afterwards
+    std::vector<double> data_x( size );
+    std::vector<double> data_y( size );
+
+    for( size_t i = 0; i < size; ++i )
+    {
+        data_x[i] = x_vector.Mag( i );
+        data_y[i] = phase ? y_vector.Phase( i ) : y_vector.Mag( i );
+    }
+
     // If we did a two-source DC analysis, we need to split the resulting vector and add traces
     // for each input step
     SPICE_DC_PARAMS source1, source2;
@@ -768,8 +788,8 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
                 std::vector<double> sub_y( data_y.begin() + offset,
                                            data_y.begin() + offset + inner );
 
-                if( aPanel->AddTrace( name, inner,
-                                      sub_x.data(), sub_y.data(), aDescriptor.GetType() ) )
+                if( aPanel->AddTrace( name, std::move( sub_x ), std::move( sub_y ),
+                                      aDescriptor.GetType() ) )
                 {
                     m_plots[aPanel].m_traces.insert( std::make_pair( name, aDescriptor ) );
                 }
@@ -782,8 +802,8 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
         }
     }
 
-    if( aPanel->AddTrace( aDescriptor.GetTitle(), size,
-                data_x.data(), data_y.data(), aDescriptor.GetType() ) )
+    if( aPanel->AddTrace( aDescriptor.GetTitle(), std::move( data_x ), std::move( data_y ),
+                aDescriptor.GetType() ) )
     {
         m_plots[aPanel].m_traces.insert( std::make_pair( aDescriptor.GetTitle(), aDescriptor ) );
     }
@@ -897,6 +917,32 @@ void SIM_PLOT_FRAME::applyTuners()
 }
 
 
+void SIM_PLOT_FRAME::updateStreaming()
+{
+    std::vector<std::string> vectors;
+    SIM_PLOT_PANEL*          plotPanel = CurrentPlot();
+
+    if( plotPanel && plotPanel->GetType() == ST_TRANSIENT
+            && m_exporter->GetSimType() == ST_TRANSIENT )
+    {
+        for( const auto& trace : m_plots[plotPanel].m_traces )
+        {
+            const TRACE_DESC& desc = trace.second;
+            wxString          vector = m_exporter->ComponentToVector( desc.GetName(),
+                                                                      desc.GetType(),
+                                                                      desc.GetParam() );
+            vectors.push_back( vector.ToStdString() );
+        }
+    }
+
+    // Only the plotted traces are collected, along with their X axis
+    if( !vectors.empty() )
+        vectors.push_back( m_simulator->GetXAxis( ST_TRANSIENT ) );
+
+    m_simulator->EnableStreaming( !vectors.empty(), vectors );
+}
+
+
 bool SIM_PLOT_FRAME::loadWorkbook( const wxString& aPath )
 {
     m_plots.clear();
@@ -1474,6 +1520,9 @@ void SIM_PLOT_FRAME::onSimStarted( wxCommandEvent& aEvent )
 {
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_stop_xpm ) );
     SetCursor( wxCURSOR_ARROWWAIT );
+
+    m_livePlotStarted = false;
+    m_livePlotTimer.Start( 250 );
 }
 
 
@@ -1481,6 +1530,11 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
 {
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_run_xpm ) );
     SetCursor( wxCURSOR_ARROW );
+    m_livePlotTimer.Stop();
+
+    // The complete vectors are read below, so drop the points that were not plotted yet
+    if( !IsSimulationRunning() )
+        m_simulator->EnableStreaming( false );
 
     SIM_TYPE simType = m_exporter->GetSimType();
 
@@ -1549,6 +1603,66 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
 }
 
 
+void SIM_PLOT_FRAME::onLivePlotTimer( wxTimerEvent& aEvent )
+{
+    // Only the new points are read, the vectors of ngspice are still being filled and are
+    // read in onSimFinished() once the simulation is done.  The points are taken even if
+    // they cannot be shown, so they do not pile up in the simulator.
+    std::map<std::string, std::vector<COMPLEX>> points;
+
+    if( !m_simulator->TakeNewPoints( points ) )
+        return;
+
+    SIM_PLOT_PANEL* plotPanel = CurrentPlot();
+
+    if( !plotPanel || plotPanel->GetType() != ST_TRANSIENT
+            || m_exporter->GetSimType() != ST_TRANSIENT )
+    {
+        return;
+    }
+
+    auto xIt = points.find( m_simulator->GetXAxis( ST_TRANSIENT ) );
+
+    if( xIt == points.end() || xIt->second.empty() )
+        return;
+
+    std::vector<double> data_x;
+    data_x.reserve( xIt->second.size() );
+
+    for( const COMPLEX& value : xIt->second )
+        data_x.push_back( value.real() );
+
+    for( const auto& trace : m_plots[plotPanel].m_traces )
+    {
+        const TRACE_DESC& desc = trace.second;
+        TRACE*            plotTrace = plotPanel->GetTrace( trace.first );
+        wxString          vector = m_exporter->ComponentToVector( desc.GetName(), desc.GetType(),
+                                                                  desc.GetParam() );
+        auto              yIt = points.find( vector.Lower().ToStdString() );
+
+        // Traces added during the run are not streamed and are only plotted once it is done
+        if( !plotTrace || yIt == points.end() || yIt->second.size() != data_x.size() )
+            continue;
+
+        std::vector<double> data_y;
+        data_y.reserve( yIt->second.size() );
+
+        for( const COMPLEX& value : yIt->second )
+            data_y.push_back( value.real() );
+
+        // The first points of a run replace the traces of the previous run
+        if( m_livePlotStarted )
+            plotTrace->AppendData( data_x, data_y );
+        else
+            plotTrace->SetData( data_x, std::move( data_y ) );
+    }
+
+    m_livePlotStarted = true;
+    plotPanel->ResetScales();
+    plotPanel->GetPlotWin()->UpdateAll();
+}
+
+
 void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
 {
     if( IsSimulationRunning() )
@@ -1566,6 +1680,7 @@ void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
         m_simConsole->Clear();
         // Do not export netlist, it is already stored in the simulator
         applyTuners();
+        updateStreaming();
         m_simulator->Run();
     }
 }
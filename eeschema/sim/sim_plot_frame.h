@@ -41,6 +41,7 @@
 #include <dialogs/dialog_sim_settings.h>
 
 #include <wx/event.h>
+#include <wx/timer.h>
 
 #include <list>
 #include <memory>
@@ -268,6 +269,13 @@ private:
      */
     void applyTuners();
 
+    /**
+     * @brief Asks the simulator to stream the vectors of the traces in the current plot, so
+     * they are refreshed while a transient simulation runs.  Streaming is disabled when
+     * there is nothing to plot live.
+     */
+    void updateStreaming();
+
     /**
      * @brief Loads plot settings from a file.
      * @param aPath is the file name.
@@ -336,6 +344,10 @@ private:
     void onSimStarted( wxCommandEvent& aEvent );
     void onSimFinished( wxCommandEvent& aEvent );
 
+    ///> Adds the points computed since the last call to the traces of a running transient
+    ///> simulation
+    void onLivePlotTimer( wxTimerEvent& aEvent );
+
     // adjust the sash dimension of splitter windows after reading
     // the config settings
     // must be called after the config settings are read, and once the
@@ -418,6 +430,12 @@ private:
     bool m_plotUseWhiteBg;
     unsigned int m_plotNumber;
 
+    ///> Refreshes the traces while a transient simulation runs
+    wxTimer m_livePlotTimer;
+
+    ///> Set once the traces of the running simulation replaced the ones of the previous run
+    bool m_livePlotStarted;
+
     ///> The color list to draw traces, bg, fg, axis...
     std::vector<wxColour> m_colorList;
 };
@@ -481,8 +481,8 @@ void SIM_PLOT_PANEL::UpdateTraceStyle( TRACE* trace )
 }
 
 
-bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
-        const double* aX, const double* aY, SIM_PLOT_TYPE aFlags )
+bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, std::vector<double> aX,
+        std::vector<double> aY, SIM_PLOT_TYPE aFlags )
 {
     TRACE* trace = NULL;
 
@@ -531,23 +531,21 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
         trace = prev->second;
     }
 
-    std::vector<double> tmp( aY, aY + aPoints );
-
     if( GetType() == ST_AC )
     {
         if( aFlags & SPT_AC_PHASE )
         {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = tmp[i] * 180.0 / M_PI;                 // convert to degrees
+            for( double& y : aY )
+                y = y * 180.0 / M_PI;                 // convert to degrees
         }
         else
         {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = 20 * log( tmp[i] ) / log( 10.0 );      // convert to dB
+            for( double& y : aY )
+                y = 20 * log( y ) / log( 10.0 );      // convert to dB
         }
     }
 
-    trace->SetData( std::vector<double>( aX, aX + aPoints ), tmp );
+    trace->SetData( std::move( aX ), std::move( aY ) );
 
     if( aFlags & SPT_AC_PHASE || aFlags & SPT_CURRENT )
         trace->SetScale( m_axis_x, m_axis_y2 );
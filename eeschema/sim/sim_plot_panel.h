@@ -105,12 +105,25 @@ public:
      * @param aX are the X axis values.
      * @param aY are the Y axis values.
      */
-    void SetData( const std::vector<double>& aX, const std::vector<double>& aY ) override
+    void SetData( std::vector<double> aX, std::vector<double> aY ) override
     {
         if( m_cursor )
             m_cursor->Update();
 
-        mpFXYVector::SetData( aX, aY );
+        mpFXYVector::SetData( std::move( aX ), std::move( aY ) );
+    }
+
+    /**
+     * @brief Adds points at the end of the trace. aX and aY need to have the same length.
+     * @param aX are the X axis values.
+     * @param aY are the Y axis values.
+     */
+    void AppendData( const std::vector<double>& aX, const std::vector<double>& aY ) override
+    {
+        if( m_cursor )
+            m_cursor->Update();
+
+        mpFXYVector::AppendData( aX, aY );
     }
 
     const std::vector<double>& GetDataX() const
@@ -195,8 +208,13 @@ public:
         return m_axis_y2 ? m_axis_y2->GetName() : "";
     }
 
-    bool AddTrace( const wxString& aName, int aPoints,
-            const double* aX, const double* aY, SIM_PLOT_TYPE aFlags );
+    /**
+     * @brief Adds a trace or replaces the data of an existing one.  The vectors are taken
+     * by value, pass them with std::move to avoid copying them.
+     * @return true if a new trace was added.
+     */
+    bool AddTrace( const wxString& aName, std::vector<double> aX, std::vector<double> aY,
+            SIM_PLOT_TYPE aFlags );
 
     bool DeleteTrace( const wxString& aName );
 
@@ -30,6 +30,8 @@
 #include <string>
 #include <vector>
 #include <complex>
+#include <cmath>
+#include <map>
 #include <memory>
 
 #include <wx/string.h>
@@ -39,6 +41,67 @@ class SPICE_SIMULATOR;
 
 typedef std::complex<double> COMPLEX;
 
+/**
+ * A read-only view of a vector stored by the simulator, to read its values without copying
+ * the vector.  The view is only valid until the next command sent to the simulator.
+ */
+class SPICE_VECTOR
+{
+public:
+    SPICE_VECTOR() :
+            m_real( nullptr ),
+            m_complex( nullptr ),
+            m_length( 0 )
+    {
+    }
+
+    /**
+     * @param aReal are the values of a real vector, or nullptr.
+     * @param aComplex are the values of a complex vector, stored as pairs of real and
+     * imaginary parts, or nullptr.
+     * @param aLength is the number of values.
+     */
+    SPICE_VECTOR( const double* aReal, const double* aComplex, size_t aLength ) :
+            m_real( aReal ),
+            m_complex( aComplex ),
+            m_length( ( aReal || aComplex ) ? aLength : 0 )
+    {
+    }
+
+    size_t size() const { return m_length; }
+
+    bool empty() const { return m_length == 0; }
+
+    bool IsComplex() const { return m_complex != nullptr; }
+
+    double Real( size_t aIdx ) const
+    {
+        return m_real ? m_real[aIdx] : m_complex[2 * aIdx];
+    }
+
+    double Imag( size_t aIdx ) const
+    {
+        return m_real ? 0.0 : m_complex[2 * aIdx + 1];
+    }
+
+    ///> Magnitude of complex values, real values are returned as they are
+    double Mag( size_t aIdx ) const
+    {
+        return m_real ? m_real[aIdx] : std::hypot( Real( aIdx ), Imag( aIdx ) );
+    }
+
+    ///> Phase of complex values in radians, 0 for real values
+    double Phase( size_t aIdx ) const
+    {
+        return m_real ? 0.0 : std::atan2( Imag( aIdx ), Real( aIdx ) );
+    }
+
+private:
+    const double* m_real;
+    const double* m_complex;
+    size_t        m_length;
+};
+
 class SPICE_SIMULATOR
 {
 public:
@@ -97,6 +160,38 @@ public:
      */
     virtual std::vector<std::string> AllPlots() = 0;
 
+    /**
+     * @brief Returns a view of a vector, without copying its values.
+     * @param aName is the vector named in Spice convention (e.g. V(3), I(R1)).
+     * @return The vector view, valid until the next command sent to the simulator.  It is
+     * empty if there is no vector with requested name.
+     */
+    virtual SPICE_VECTOR GetVector( const std::string& aName ) = 0;
+
+    /**
+     * @brief Collects the points computed by the next simulations as they run, so they can
+     * be plotted before the simulation ends with TakeNewPoints().  Disabling streaming drops
+     * the points that have not been taken yet.
+     * @param aVectors are the vectors to collect, named in Spice convention (e.g. V(3),
+     * I(V1), @r1[i]).  The X axis vector has to be listed as well, other vectors of the
+     * simulation are not collected.
+     */
+    virtual void EnableStreaming( bool aEnable,
+                                  const std::vector<std::string>& aVectors = {} ) {}
+
+    /**
+     * @brief Moves out the points computed since the simulation started or since the
+     * previous call, while streaming is enabled.
+     * @param aPoints receives the new values of the streamed vectors, indexed by the
+     * lowercase names given to EnableStreaming().  All the vectors get the same number of
+     * new values; vectors the simulator does not produce are missing.
+     * @return false if streaming is not enabled or not supported.
+     */
+    virtual bool TakeNewPoints( std::map<std::string, std::vector<COMPLEX>>& aPoints )
+    {
+        return false;
+    }
+
     /**
      * @brief Returns a requested vector with complex values. If the vector is real, then
      * the imaginary part is set to 0 in all values.
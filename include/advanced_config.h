@@ -83,6 +83,11 @@ public:
      */
     int m_coroutineStackSize;
 
+    /**
+     * Minimum on-screen size (in pixels) of a cached item to be drawn in full (0 = always)
+     */
+    double m_minItemScreenSize;
+
 
 private:
     ADVANCED_CFG();
@@ -77,6 +77,7 @@ private:
     bool        m_FlagModified;     ///< Indicates current drawing has been modified.
     bool        m_FlagSave;         ///< Indicates automatic file save.
     int         m_UndoRedoCountMax; ///< undo/Redo command Max depth
+    int         m_UndoRedoMemoryMax; ///< undo/Redo memory budget in MB, 0 for no limit
 
     /**
      * The cross hair position in logical (drawing) units.  The cross hair is not the cursor
@@ -89,6 +90,12 @@ private:
     GRID_TYPE   m_Grid;             ///< Current grid selection.
     double      m_Zoom;             ///< Current zoom coefficient.
 
+    /**
+     * Function trimUndoORRedoList
+     * deletes the oldest commands of \a aList until it fits in the memory budget
+     */
+    void trimUndoORRedoList( UNDO_REDO_CONTAINER& aList );
+
     //----< Old public API now is private, and migratory>------------------------
     // called only from EDA_DRAW_FRAME
     friend class EDA_DRAW_FRAME;
@@ -160,6 +167,21 @@ public:
      */
     virtual void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) = 0;
 
+    /**
+     * Function GetCommandMemoryUsage (virtual).
+     * estimates the memory held by a command, i.e. by the item copies it owns.
+     * Screens which do not estimate it return 0, and are only limited by the
+     * max count of commands.
+     * It is called again for all the commands of a list when a command is pushed,
+     * so it must only read the items owned by the command.
+     * @param aCommand = the command to estimate
+     * @return the estimated size in bytes
+     */
+    virtual size_t GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const
+    {
+        return 0;
+    }
+
     /**
      * Function ClearUndoRedoList
      * clear undo and redo list, using ClearUndoORRedoList()
@@ -171,8 +193,8 @@ public:
     /**
      * Function PushCommandToUndoList
      * add a command to undo in undo list
-     * delete the very old commands when the max count of undo commands is
-     * reached
+     * delete the very old commands when the max count of undo commands or
+     * the undo memory budget is reached
      * ( using ClearUndoORRedoList)
      */
     virtual void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem );
@@ -180,8 +202,8 @@ public:
     /**
      * Function PushCommandToRedoList
      * add a command to redo in redo list
-     * delete the very old commands when the max count of redo commands is
-     * reached
+     * delete the very old commands when the max count of redo commands or
+     * the redo memory budget is reached
      * ( using ClearUndoORRedoList)
      */
     virtual void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem );
@@ -221,6 +243,24 @@ public:
         }
     }
 
+    int GetMaxUndoMemory() const { return m_UndoRedoMemoryMax; }
+
+    /**
+     * Function SetMaxUndoMemory
+     * sets the memory budget of each of the undo and redo lists
+     * @param aMegabytes = the budget in MB, 0 for no limit
+     */
+    void SetMaxUndoMemory( int aMegabytes )
+    {
+        if( aMegabytes >= 0 )
+            m_UndoRedoMemoryMax = aMegabytes;
+        else
+        {
+            wxFAIL_MSG( "Undo memory budget not within limits" );
+            m_UndoRedoMemoryMax = DEFAULT_MAX_UNDO_MEMORY;
+        }
+    }
+
     void SetModify()        { m_FlagModified = true; }
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
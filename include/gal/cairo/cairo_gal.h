@@ -30,6 +30,7 @@
 #define CAIROGAL_H_
 
 #include <map>
+#include <unordered_map>
 #include <iterator>
 
 #include <cairo.h>
@@ -288,7 +289,7 @@ protected:
     bool                        isGrouping;         ///< Is grouping enabled ?
     bool                        isElementAdded;     ///< Was an graphic element added ?
     typedef std::deque<GROUP_ELEMENT> GROUP;        ///< A graphic group type definition
-    std::map<int, GROUP>        groups;             ///< List of graphic groups
+    std::unordered_map<int, GROUP> groups;          ///< List of graphic groups
     unsigned int                groupCounter;       ///< Counter used for generating keys for groups
     GROUP*                      currentGroup;       ///< Currently used group
 
@@ -31,6 +31,9 @@
 
 #include <deque>
 #include <algorithm>
+#include <list>
+#include <map>
+#include <string>
 
 #include <utf8.h>
 
@@ -42,8 +45,30 @@ namespace KIGFX
 {
 class GAL;
 
-typedef std::vector<std::vector<VECTOR2D>*> GLYPH;
-typedef std::vector<GLYPH*>                 GLYPH_LIST;
+/// A polyline of a glyph: a range of the point table of the font
+struct GLYPH_STROKE
+{
+    unsigned int m_firstPoint;
+    unsigned int m_pointCount;
+};
+
+/// A glyph: a range of the stroke table of the font
+struct GLYPH
+{
+    unsigned int m_firstStroke;
+    unsigned int m_strokeCount;
+};
+
+/**
+ * The decoded font. All the glyphs share the same point and stroke tables, so the
+ * whole font is stored in a few allocations.
+ */
+struct GLYPH_LIST
+{
+    std::vector<VECTOR2D>     m_points;
+    std::vector<GLYPH_STROKE> m_strokes;
+    std::vector<GLYPH>        m_glyphs;
+};
 
 /**
  * @brief Class STROKE_FONT implements stroke font drawing.
@@ -114,10 +139,48 @@ public:
 
 
 private:
+    /// Parameters giving the geometry of a line of text, in the text coordinates
+    struct LINE_CACHE_KEY
+    {
+        std::string m_text;
+        VECTOR2D    m_glyphSize;
+        double      m_lineWidth;
+        bool        m_italic;
+        bool        m_mirrored;
+
+        bool operator<( const LINE_CACHE_KEY& aOther ) const;
+    };
+
+    /// Geometry of a line of text, ready to be drawn
+    struct LINE_CACHE_ENTRY
+    {
+        VECTOR2D                          m_textSize;
+        std::vector<std::deque<VECTOR2D>> m_polylines;
+        std::vector<VECTOR2D>             m_overbars;     ///< start and end points of overbars
+        std::list<const LINE_CACHE_KEY*>::iterator m_lruPosition;
+    };
+
     GAL*                      m_gal;                  ///< Pointer to the GAL
     const GLYPH_LIST*         m_glyphs;               ///< Glyph list
     const std::vector<BOX2D>* m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
 
+    /// Most recently drawn lines of text; texts are redrawn far more often than modified
+    std::map<LINE_CACHE_KEY, LINE_CACHE_ENTRY> m_lineCache;
+    std::list<const LINE_CACHE_KEY*>           m_lineCacheLru;  ///< most recent first
+
+    /**
+     * @brief Returns the geometry of a line of text for the current GAL text attributes,
+     * from the line cache or computed and added to the cache.
+     *
+     * @param aText is the text string (one line).
+     */
+    const LINE_CACHE_ENTRY& getLineGeometry( const UTF8& aText );
+
+    /**
+     * @brief Computes the geometry of a line of text for the current GAL text attributes.
+     */
+    void computeLineGeometry( const UTF8& aText, LINE_CACHE_ENTRY& aEntry ) const;
+
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
      * a only one line text.
@@ -141,7 +204,7 @@ private:
      * @param aGlyphWidth is the x-component of the bounding box size.
      * @return is the complete bounding box size.
      */
-    BOX2D computeBoundingBox( const GLYPH* aGlyph, double aGlyphWidth ) const;
+    BOX2D computeBoundingBox( const GLYPH& aGlyph, double aGlyphWidth ) const;
 
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
@@ -181,6 +244,9 @@ private:
 
     ///> Factor that determines the pitch between 2 lines.
     static const double INTERLINE_PITCH_RATIO;
+
+    ///> Max number of lines of text kept in the line cache
+    static const size_t LINE_CACHE_SIZE;
 };
 } // namespace KIGFX
 
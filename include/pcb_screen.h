@@ -75,6 +75,13 @@ public:
      * So this function can be called to remove old commands
      */
     void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) override;
+
+    /**
+     * Function GetCommandMemoryUsage
+     * estimates the memory held by the item copies of a command, zone fills and
+     * footprint children included, for the undo/redo memory budget
+     */
+    size_t GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const override;
 };
 
 #endif  // PCB_SCREEN_H
@@ -33,6 +33,7 @@
 #define PLOT_COMMON_H_
 
 #include <vector>
+#include <unordered_map>
 #include <math/box2.h>
 #include <gr_text.h>
 #include <page_info.h>
@@ -1410,6 +1411,37 @@ protected:
     std::vector<APERTURE> m_apertures; // The list of available apertures
     int     m_currentApertureIdx;      // The index of the current aperture in m_apertures
 
+    // The key used to find an aperture in m_apertures from its type, size and attribute
+    struct APERTURE_KEY
+    {
+        int m_Type;
+        int m_SizeX;
+        int m_SizeY;
+        int m_Attribute;
+
+        bool operator==( const APERTURE_KEY& aOther ) const
+        {
+            return m_Type == aOther.m_Type && m_SizeX == aOther.m_SizeX
+                    && m_SizeY == aOther.m_SizeY && m_Attribute == aOther.m_Attribute;
+        }
+    };
+
+    struct APERTURE_KEY_HASH
+    {
+        std::size_t operator()( const APERTURE_KEY& aKey ) const
+        {
+            std::size_t seed = 0;
+
+            for( int value : { aKey.m_Type, aKey.m_SizeX, aKey.m_SizeY, aKey.m_Attribute } )
+                seed ^= std::hash<int>()( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+
+            return seed;
+        }
+    };
+
+    // Index of apertures in m_apertures, to avoid a linear search for each flashed item
+    std::unordered_map<APERTURE_KEY, int, APERTURE_KEY_HASH> m_apertureIndex;
+
     bool    m_gerberUnitInch;          // true if the gerber units are inches, false for mm
     int     m_gerberUnitFmt;           // number of digits in mantissa.
                                        // usually 6 in Inches and 5 or 6  in mm
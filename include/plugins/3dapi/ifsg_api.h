@@ -29,6 +29,7 @@
 #ifndef IFSG_API_H
 #define IFSG_API_H
 
+#include <string>
 #include "plugins/3dapi/sg_types.h"
 #include "plugins/3dapi/sg_base.h"
 #include "plugins/3dapi/c3dmodel.h"
@@ -76,11 +77,39 @@ namespace S3D
      * reads a binary cache file and creates an SGNODE tree
      *
      * @param aFileName is the name of the binary cache file to be read
+     * @param aPluginInfo, if not NULL, receives the plugin tag stored in the file
      * @return NULL on failure, on success a pointer to the top level SCENEGRAPH node;
      * if desired this node can be associated with an IFSG_TRANSFORM wrapper via
      * the IFSG_TRANSFORM::Attach() function.
      */
     SGLIB_API SGNODE* ReadCache( const char* aFileName, void* aPluginMgr,
+        bool (*aTagCheck)( const char*, void* ), std::string* aPluginInfo = NULL );
+
+    /**
+     * Function WriteModelCache
+     * writes the render data of a model to a binary cache file. Unlike the
+     * SGNODE cache, the file holds the flat vertex, normal, index and material
+     * arrays of the S3DMODEL, so it can be read back without building a scene graph.
+     *
+     * @param aFileName is the name of the file to write
+     * @param aModel is the render data to be written
+     * @param aPluginInfo is the tag of the plugin which loaded the model, as
+     * written by WriteCache()
+     * @return true on success
+     */
+    SGLIB_API bool WriteModelCache( const char* aFileName, const S3DMODEL* aModel,
+        const char* aPluginInfo );
+
+    /**
+     * Function ReadModelCache
+     * reads a binary cache file written by WriteModelCache(); as for ReadCache(),
+     * the file is rejected if aTagCheck does not accept its plugin tag
+     *
+     * @param aFileName is the name of the binary cache file to be read
+     * @return NULL on failure, on success an S3DMODEL which must be freed
+     * with Destroy3DModel()
+     */
+    SGLIB_API S3DMODEL* ReadModelCache( const char* aFileName, void* aPluginMgr,
         bool (*aTagCheck)( const char*, void* ) );
 
     /**
@@ -111,6 +111,7 @@ public:
     {
         bool                  first_run_shown;
         int                   max_undo_items;
+        int                   max_undo_memory;  ///< Undo/redo memory budget in MB, 0 for none
         std::vector<wxString> file_history;
         int                   units;
     };
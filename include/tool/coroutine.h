@@ -28,6 +28,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <new>
 #include <type_traits>
 
 #ifdef KICAD_USE_VALGRIND
@@ -37,6 +38,7 @@
 #include <libcontext.h>
 #include <memory>
 #include <advanced_config.h>
+#include <tool/coroutine_stack_pool.h>
 
 /**
  *  Class COROUNTINE.
@@ -142,6 +144,7 @@ public:
      * Creates a coroutine from a delegate object
      */
     COROUTINE( std::function<ReturnType(ArgType)> aEntry ) :
+        m_stack{ nullptr, 0 },
         m_func( std::move( aEntry ) ),
         m_running( false ),
         m_args( 0 ),
@@ -161,6 +164,8 @@ public:
 #ifdef KICAD_USE_VALGRIND
         VALGRIND_STACK_DEREGISTER( valgrind_stack );
 #endif
+
+        COROUTINE_STACK_POOL::Get().Release( m_stack );
     }
 
 public:
@@ -298,23 +303,28 @@ private:
 
         m_args = &aArgs;
 
-        assert( m_stack == nullptr );
+        assert( m_stack.m_base == nullptr );
 
         size_t stackSize = m_stacksize;
         void* sp = nullptr;
 
         #ifndef LIBCONTEXT_HAS_OWN_STACK
-        // fixme: Clean up stack stuff. Add a guard
-        m_stack.reset( new char[stackSize] );
+        // The pooled stacks have a guard page below them, an overflow faults right away
+        m_stack = COROUTINE_STACK_POOL::Get().Acquire( stackSize );
+
+        if( !m_stack.m_base )
+            throw std::bad_alloc();
+
+        stackSize = m_stack.m_size;
 
         // align to 16 bytes
-        sp = (void*)((((ptrdiff_t) m_stack.get()) + stackSize - 0xf) & (~0x0f));
+        sp = (void*)((((ptrdiff_t) m_stack.m_base) + stackSize - 0xf) & (~0x0f));
 
         // correct the stack size
-        stackSize -= size_t( ( (ptrdiff_t) m_stack.get() + stackSize ) - (ptrdiff_t) sp );
+        stackSize -= size_t( ( (ptrdiff_t) m_stack.m_base + stackSize ) - (ptrdiff_t) sp );
 
 #ifdef KICAD_USE_VALGRIND
-        valgrind_stack = VALGRIND_STACK_REGISTER( sp, m_stack.get() );
+        valgrind_stack = VALGRIND_STACK_REGISTER( sp, m_stack.m_base );
 #endif
         #endif
 
@@ -376,8 +386,8 @@ private:
         }
     }
 
-    ///< coroutine stack
-    std::unique_ptr<char[]> m_stack;
+    ///< coroutine stack, from the COROUTINE_STACK_POOL
+    COROUTINE_STACK_POOL::STACK m_stack;
 
     int m_stacksize;
 
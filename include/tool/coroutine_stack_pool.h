@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __COROUTINE_STACK_POOL_H
+#define __COROUTINE_STACK_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * A pool of stacks for the COROUTINEs.
+ *
+ * The stacks are mapped directly from the system, with a guard page below the stack
+ * (the stacks grow down), so an overflow is a crash at the faulting access rather than
+ * a silent corruption of the heap.  Released stacks are kept for the next coroutines,
+ * so the frequent tool invocations do not map and unmap large blocks each time.
+ */
+class COROUTINE_STACK_POOL
+{
+public:
+    /// A stack acquired from the pool.  The guard page is below m_base.
+    struct STACK
+    {
+        char*  m_base;      ///< lowest usable address
+        size_t m_size;      ///< usable size, from m_base
+    };
+
+    /// Return the pool shared by all the coroutines.
+    static COROUTINE_STACK_POOL& Get();
+
+    ~COROUTINE_STACK_POOL();
+
+    /**
+     * Return a stack of at least aSize bytes, reusing a released one if possible.
+     * @return the stack, with m_base set to nullptr if the system is out of memory.
+     */
+    STACK Acquire( size_t aSize );
+
+    /**
+     * Give back a stack returned by Acquire(), for a later Acquire().
+     */
+    void Release( const STACK& aStack );
+
+    /// Number of stacks mapped from the system since the start.
+    size_t GetMappedCount() const;
+
+    /// Number of Acquire() calls served with a released stack.
+    size_t GetReusedCount() const;
+
+    /// Number of stacks currently kept by the pool, in use or not.
+    size_t GetStackCount() const;
+
+    /**
+     * Return the deepest use of any stack of the pool, in bytes.  A stack is zero filled when
+     * mapped, so its use is found by scanning it up from the bottom to the first written
+     * byte.  This is slow and meant for diagnostics only.
+     */
+    size_t GetHighWaterMark() const;
+
+    /// Max number of released stacks kept for reuse, the others are unmapped
+    static const size_t MAX_FREE_STACKS;
+
+private:
+    COROUTINE_STACK_POOL();
+
+    STACK mapStack( size_t aSize );
+    void  unmapStack( const STACK& aStack );
+
+    mutable std::mutex m_lock;
+
+    std::vector<STACK> m_stacks;        ///< all the stacks of the pool
+    std::vector<STACK> m_freeStacks;    ///< the released stacks
+
+    size_t             m_mapped;
+    size_t             m_reused;
+    size_t             m_pageSize;
+};
+
+#endif
@@ -535,7 +535,10 @@ public:
 
     /**
      * Function RecacheAllItems()
-     * Rebuilds GAL display lists.
+     * Drops the GAL display lists of all items on cached layers and marks the items for
+     * update.  The display lists are rebuilt by the next UpdateItems() call (every repaint
+     * starts with one), which batches them per layer, so callers may keep modifying the items
+     * or the painter settings afterwards without paying for an intermediate rebuild.
      */
     void RecacheAllItems();
 
@@ -698,6 +701,21 @@ public:
      */
     void SetPrintMode( int aPrintMode ) { m_printMode = aPrintMode; }
 
+    /**
+     * Function SetMinimumItemScreenSize()
+     * Sets the size (in pixels) below which items on cached layers are drawn as a one pixel
+     * dot instead of their full geometry. Such items would end up as sub-pixel specks anyway,
+     * but at low zoom levels on large boards they make up most of the submitted geometry.
+     * @param aPixels is the minimal size of the item bounding box, 0 always draws full items.
+     */
+    void SetMinimumItemScreenSize( double aPixels ) { m_minItemScreenSize = aPixels; }
+
+    /**
+     * Function GetMinimumItemScreenSize()
+     * @return the size (in pixels) below which items on cached layers are drawn simplified.
+     */
+    double GetMinimumItemScreenSize() const { return m_minItemScreenSize; }
+
     static constexpr int VIEW_MAX_LAYERS = 512;      ///< maximum number of layers that may be shown
 
 protected:
@@ -769,6 +787,16 @@ protected:
      */
     void draw( VIEW_GROUP* aGroup, bool aImmediate = false );
 
+    /**
+     * Function drawStandIn()
+     * Draws the simplified representation of an item that is too small to be seen on the
+     * screen: a one pixel wide line across its bounding box, cached in a separate group.
+     *
+     * @param aItem is the item to be drawn.
+     * @param aLayer is the cached layer which should be drawn.
+     */
+    void drawStandIn( VIEW_ITEM* aItem, int aLayer );
+
     ///* Sorts m_orderedLayers when layer rendering order has changed
     void sortLayers();
 
@@ -784,12 +812,23 @@ protected:
      */
     void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags );
 
+    /**
+     * Function invalidateItems()
+     * Batched version of invalidateItem(): processes the pending update flags of all the
+     * given items, recaching the geometry one layer at a time.
+     * @param aItems is the list of items to be updated.
+     */
+    void invalidateItems( const std::vector<VIEW_ITEM*>& aItems );
+
     /// Updates colors that are used for an item to be drawn
     void updateItemColor( VIEW_ITEM* aItem, int aLayer );
 
     /// Updates all informations needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    /// Redraws an item into a new cached group, assuming the GAL target is already set up
+    void cacheItemGeometry( VIEW_ITEM* aItem, int aLayer );
+
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -871,6 +910,9 @@ protected:
     /// m_printMode > 0 is a printing mode (currently means "we are in printing mode")
     int m_printMode;
 
+    /// Items on cached layers with a bounding box smaller than this (in pixels) are not drawn
+    double m_minItemScreenSize;
+
     VIEW( const VIEW& ) = delete;
 };
 } // namespace KIGFX
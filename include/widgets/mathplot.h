@@ -1575,15 +1575,30 @@ public:
 
     /** Changes the internal data: the set of points to draw.
      *  Both vectors MUST be of the same length. This method DOES NOT refresh the mpWindow; do it manually.
+     *  The vectors are taken by value, pass them with std::move to avoid copying them.
      * @sa Clear
      */
-    virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
+    virtual void SetData( std::vector<double> xs, std::vector<double> ys );
+
+    /** Adds points after the current ones, updating the bounding box and the min/max
+     *  pyramid for the new points only.
+     *  Both vectors MUST be of the same length. This method DOES NOT refresh the mpWindow; do it manually.
+     * @sa SetData
+     */
+    virtual void AppendData( const std::vector<double>& xs, const std::vector<double>& ys );
 
     /** Clears all the data, leaving the layer empty.
      * @sa SetData
      */
     void Clear();
 
+    /** Layer plot handler.
+     *  When the visible part of a continuous plot has many more points than there are pixels,
+     *  the plot is drawn from the min/max of the points in each pixel column (taken from a
+     *  pyramid built by SetData) rather than from every point.
+     */
+    virtual void Plot( wxDC& dc, mpWindow& w ) override;
+
 protected:
     /** The internal copy of the set of data to draw.
      */
@@ -1593,7 +1608,48 @@ protected:
      */
     size_t m_index;
 
-    /** Loaded at SetData
+    /** The extreme Y values of a range of consecutive points, in the order they come in
+     *  (the min first if it comes before the max, and the other way round).
+     */
+    struct MINMAX
+    {
+        double first;
+        double second;
+    };
+
+    /** Min/max pyramid of m_ys, built at SetData for large data sets sorted by X, and
+     *  extended by AppendData.
+     *  The buckets of level i cover DECIMATION_BUCKET << i points each.
+     */
+    std::vector<std::vector<MINMAX>> m_minmax;
+
+    /** The points drawn by the current Plot() call when it is decimated.
+     *  GetNextXY() returns these instead of m_xs, m_ys while m_decimated is set.
+     */
+    std::vector<double> m_decimatedXs, m_decimatedYs;
+    bool m_decimated;
+
+    /// Number of points of the buckets of the first level of m_minmax
+    static const size_t DECIMATION_BUCKET = 4;
+
+    /// Data sets smaller than this are always drawn point by point
+    static const size_t DECIMATION_MIN_POINTS = 8192;
+
+    /** Updates m_minmax for the points of m_xs, m_ys from aFirst, the previous ones being
+     *  unchanged.  aFirst = 0 rebuilds the whole pyramid.
+     */
+    void buildMinMax( size_t aFirst );
+
+    /** Extends the bounding box to the points from aFirst.
+     */
+    void updateBounds( size_t aFirst );
+
+    /** Fills m_decimatedXs, m_decimatedYs with the points to draw the visible part of the data.
+     *  @return false if the data should be drawn point by point instead
+     */
+    bool decimate( mpWindow& w );
+
+    /** Loaded at SetData and AppendData
      */
     double m_minX, m_maxX, m_minY, m_maxY;
 
@@ -240,7 +240,7 @@ class SHAPE_POLY_SET : public SHAPE
 
             const T& Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].CPoint(
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CPoint(
                         m_currentVertex );
             }
 
@@ -363,7 +363,8 @@ class SHAPE_POLY_SET : public SHAPE
 
             T Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].Segment( m_currentSegment );
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CSegment(
+                        m_currentSegment );
             }
 
             T operator*()
@@ -446,9 +447,11 @@ class SHAPE_POLY_SET : public SHAPE
 
         /**
          * Copy constructor SHAPE_POLY_SET
-         * Performs a deep copy of \p aOther into \p this.
+         * The polygons and the triangulation of \p aOther are shared with \p this; the
+         * polygons are copied only when one of the two sets is modified.
          * @param aOther is the SHAPE_POLY_SET object that will be copied.
-         * @param aDeepCopy if true, make new copies of the triangulated unique_ptr vector
+         * @param aDeepCopy if true, make new copies of the polygons and the triangulation
+         * right away, instead of sharing them
          */
         SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy = false );
 
@@ -477,7 +480,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return bool - true if the relative indices are correct; false otherwise. The computed
          *              global index is returned in the \p aGlobalIdx reference.
          */
-        bool GetGlobalIndex( VERTEX_INDEX aRelativeIndices, int& aGlobalIdx );
+        bool GetGlobalIndex( VERTEX_INDEX aRelativeIndices, int& aGlobalIdx ) const;
 
         /// @copydoc SHAPE::Clone()
         SHAPE* Clone() const override;
@@ -545,7 +548,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aNext - the globalIndex of the next corner of the same contour.
          * @return true if OK, false if aGlobalIndex is out of range
          */
-        bool GetNeighbourIndexes( int aGlobalIndex, int* aPrevious, int* aNext );
+        bool GetNeighbourIndexes( int aGlobalIndex, int* aPrevious, int* aNext ) const;
 
 
         /**
@@ -1128,7 +1131,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return POLYGON - A polygon containing the chamfered version of the aIndex-th polygon.
          */
         POLYGON ChamferPolygon( unsigned int aDistance, int aIndex,
-                                std::set<VECTOR2I>* aPreserveCorners );
+                                std::set<VECTOR2I>* aPreserveCorners ) const;
 
         /**
          * Function Fillet
@@ -1140,7 +1143,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return POLYGON - A polygon containing the filleted version of the aIndex-th polygon.
          */
         POLYGON FilletPolygon( unsigned int aRadius, int aErrorMax, int aIndex,
-                               std::set<VECTOR2I>* aPreserveCorners = nullptr );
+                               std::set<VECTOR2I>* aPreserveCorners = nullptr ) const;
 
         /**
          * Function Chamfer
@@ -1150,7 +1153,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return SHAPE_POLY_SET - A set containing the chamfered version of this set.
          */
         SHAPE_POLY_SET Chamfer( int aDistance,
-                                std::set<VECTOR2I>* aPreserveCorners = nullptr );
+                                std::set<VECTOR2I>* aPreserveCorners = nullptr ) const;
 
         /**
          * Function Fillet
@@ -1161,7 +1164,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return SHAPE_POLY_SET - A set containing the filleted version of this set.
          */
         SHAPE_POLY_SET Fillet( int aRadius, int aErrorMax,
-                               std::set<VECTOR2I>* aPreserveCorners = nullptr );
+                               std::set<VECTOR2I>* aPreserveCorners = nullptr ) const;
 
         /**
          * Function DistanceToPolygon
@@ -1171,7 +1174,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return int -  The minimum distance between aPoint and all the segments of the aIndex-th
          *                polygon. If the point is contained in the polygon, the distance is zero.
          */
-        SEG::ecoord SquaredDistanceToPolygon( VECTOR2I aPoint, int aIndex );
+        SEG::ecoord SquaredDistanceToPolygon( VECTOR2I aPoint, int aIndex ) const;
 
         /**
          * Function DistanceToPolygon
@@ -1185,7 +1188,7 @@ class SHAPE_POLY_SET : public SHAPE
          *                  aIndex-th polygon. If the point is contained in the polygon, the
          *                  distance is zero.
          */
-        SEG::ecoord SquaredDistanceToPolygon( const SEG& aSegment, int aIndex );
+        SEG::ecoord SquaredDistanceToPolygon( const SEG& aSegment, int aIndex ) const;
 
         /**
          * Function SquaredDistance
@@ -1195,7 +1198,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return The minimum distance squared between aPoint and all the polygons in the set.
          *         If the point is contained in any of the polygons, the distance is zero.
          */
-        SEG::ecoord SquaredDistance( VECTOR2I aPoint );
+        SEG::ecoord SquaredDistance( VECTOR2I aPoint ) const;
 
         /**
          * Function SquaredDistance
@@ -1206,7 +1209,7 @@ class SHAPE_POLY_SET : public SHAPE
          * @return  The minimum distance squared between aSegment and all the polygons in the set.
          *          If the point is contained in the polygon, the distance is zero.
          */
-        SEG::ecoord SquaredDistance( const SEG& aSegment );
+        SEG::ecoord SquaredDistance( const SEG& aSegment ) const;
 
         /**
          * Function IsVertexInHole.
@@ -1284,14 +1287,80 @@ class SHAPE_POLY_SET : public SHAPE
          */
         POLYGON chamferFilletPolygon( CORNER_MODE aMode, unsigned int aDistance,
                                       int aIndex, int aErrorMax,
-                                      std::set<VECTOR2I>* aPreserveCorners );
+                                      std::set<VECTOR2I>* aPreserveCorners ) const;
 
         ///> Returns true if the polygon set has any holes that touch share a vertex.
         bool hasTouchingHoles( const POLYGON& aPoly ) const;
 
         typedef std::vector<POLYGON> POLYSET;
 
-        POLYSET m_polys;
+        /**
+         * Reference counted storage of the polygons, shared between copies of a set until
+         * one of them is modified.  The const accessors read the shared polygons, the other
+         * ones first make a private copy of them if they are shared (copy-on-write).
+         * References obtained from a non-const accessor must not be kept across a copy of
+         * the set.
+         */
+        class POLYSET_STORAGE
+        {
+        public:
+            typedef POLYSET::iterator       iterator;
+            typedef POLYSET::const_iterator const_iterator;
+
+            POLYSET_STORAGE() :
+                m_data( std::make_shared<POLYSET>() )
+            {
+            }
+
+            size_t size() const { return m_data->size(); }
+            bool empty() const { return m_data->empty(); }
+
+            POLYGON& operator[]( size_t aIndex ) { return detach()[aIndex]; }
+            const POLYGON& operator[]( size_t aIndex ) const { return ( *m_data )[aIndex]; }
+
+            POLYGON& back() { return detach().back(); }
+            const POLYGON& back() const { return m_data->back(); }
+
+            iterator begin() { return detach().begin(); }
+            iterator end() { return detach().end(); }
+            const_iterator begin() const { return m_data->cbegin(); }
+            const_iterator end() const { return m_data->cend(); }
+
+            void push_back( const POLYGON& aPolygon ) { detach().push_back( aPolygon ); }
+
+            iterator erase( iterator aPos ) { return detach().erase( aPos ); }
+
+            iterator insert( iterator aPos, const_iterator aFirst, const_iterator aLast )
+            {
+                return detach().insert( aPos, aFirst, aLast );
+            }
+
+            ///> Releases the shared polygons instead of copying them to clear the copy
+            void clear() { m_data = std::make_shared<POLYSET>(); }
+
+            ///> Returns true if both storages hold the same shared polygons
+            bool SharesWith( const POLYSET_STORAGE& aOther ) const
+            {
+                return m_data == aOther.m_data;
+            }
+
+            ///> Returns the number of storages holding the polygons, this one included
+            long UseCount() const { return m_data.use_count(); }
+
+            ///> Makes a private copy of the polygons if they are shared
+            POLYSET& detach()
+            {
+                if( m_data.use_count() > 1 )
+                    m_data = std::make_shared<POLYSET>( *m_data );
+
+                return *m_data;
+            }
+
+        private:
+            std::shared_ptr<POLYSET> m_data;
+        };
+
+        POLYSET_STORAGE m_polys;
 
     public:
 
@@ -1300,13 +1369,31 @@ class SHAPE_POLY_SET : public SHAPE
         void CacheTriangulation();
         bool IsTriangulationUpToDate() const;
 
+        /**
+         * @return true if this set and \p aOther share their polygons, i.e. one of them is a
+         * copy of the other and none of them was modified since.
+         */
+        bool SharesPolygonsWith( const SHAPE_POLY_SET& aOther ) const
+        {
+            return m_polys.SharesWith( aOther.m_polys );
+        }
+
+        /**
+         * @return the number of sets sharing the polygons of this set, this one included.
+         */
+        long GetPolygonsShareCount() const
+        {
+            return m_polys.UseCount();
+        }
+
         MD5_HASH GetHash() const;
 
     private:
 
         MD5_HASH checksum() const;
 
-        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
+        ///> Triangulated polygons are never modified once built, so they are shared by copies
+        std::vector<std::shared_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
         bool m_triangulationValid = false;
         MD5_HASH m_hash;
 
@@ -70,11 +70,21 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_LINE_CHAIN& aOutline ) :
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy ) :
     SHAPE( SH_POLY_SET ), m_polys( aOther.m_polys )
 {
+    if( aDeepCopy )
+        m_polys.detach();
+
     if( aOther.IsTriangulationUpToDate() )
     {
-        for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
-            m_triangulatedPolys.push_back(
-                    std::make_unique<TRIANGULATED_POLYGON>( *aOther.TriangulatedPolygon( i ) ) );
+        if( aDeepCopy )
+        {
+            for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
+                m_triangulatedPolys.push_back( std::make_shared<TRIANGULATED_POLYGON>(
+                        *aOther.TriangulatedPolygon( i ) ) );
+        }
+        else
+        {
+            m_triangulatedPolys = aOther.m_triangulatedPolys;
+        }
 
         m_hash = aOther.GetHash();
         m_triangulationValid = true;
@@ -134,7 +144,7 @@ bool SHAPE_POLY_SET::GetRelativeIndices( int aGlobalIdx,
 
 
 bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndices,
-        int& aGlobalIdx )
+        int& aGlobalIdx ) const
 {
     int selectedVertex = aRelativeIndices.m_vertex;
     unsigned int    selectedContour = aRelativeIndices.m_contour;
@@ -144,13 +154,11 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
     if( selectedPolygon < m_polys.size() && selectedContour < m_polys[selectedPolygon].size()
         && selectedVertex < m_polys[selectedPolygon][selectedContour].PointCount() )
     {
-        POLYGON currentPolygon;
-
         aGlobalIdx = 0;
 
         for( unsigned int polygonIdx = 0; polygonIdx < selectedPolygon; polygonIdx++ )
         {
-            currentPolygon = Polygon( polygonIdx );
+            const POLYGON& currentPolygon = CPolygon( polygonIdx );
 
             for( unsigned int contourIdx = 0; contourIdx < currentPolygon.size(); contourIdx++ )
             {
@@ -158,7 +166,7 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
             }
         }
 
-        currentPolygon = Polygon( selectedPolygon );
+        const POLYGON& currentPolygon = CPolygon( selectedPolygon );
 
         for( unsigned int contourIdx = 0; contourIdx < selectedContour; contourIdx++ )
         {
@@ -327,7 +335,7 @@ const VECTOR2I& SHAPE_POLY_SET::CVertex( SHAPE_POLY_SET::VERTEX_INDEX index ) co
 }
 
 
-bool SHAPE_POLY_SET::GetNeighbourIndexes( int aGlobalIndex, int* aPrevious, int* aNext )
+bool SHAPE_POLY_SET::GetNeighbourIndexes( int aGlobalIndex, int* aPrevious, int* aNext ) const
 {
     SHAPE_POLY_SET::VERTEX_INDEX index;
 
@@ -580,7 +588,11 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
         break;
     }
 
-    for( const POLYGON& poly : m_polys )
+    // Read the polygons through a const reference: they are replaced by the result, so
+    // there is no point in copying them first if they are shared
+    const POLYSET_STORAGE& polys = m_polys;
+
+    for( const POLYGON& poly : polys )
     {
         for( size_t i = 0; i < poly.size(); i++ )
             c.AddPath( poly[i].convertToClipper( i == 0 ), joinType, etClosedPolygon );
@@ -1559,7 +1571,7 @@ int SHAPE_POLY_SET::TotalVertices() const
 
 
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance, int aIndex,
-                                                        std::set<VECTOR2I>* aPreserveCorners )
+                                                        std::set<VECTOR2I>* aPreserveCorners ) const
 {
     return chamferFilletPolygon( CHAMFERED, aDistance, aIndex, 0, aPreserveCorners );
 }
@@ -1567,13 +1579,13 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance,
 
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::FilletPolygon( unsigned int aRadius, int aErrorMax,
                                                        int aIndex,
-                                                       std::set<VECTOR2I>* aPreserveCorners )
+                                                       std::set<VECTOR2I>* aPreserveCorners ) const
 {
     return chamferFilletPolygon( FILLETED, aRadius, aIndex, aErrorMax, aPreserveCorners );
 }
 
 
-SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex )
+SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex ) const
 {
     // We calculate the min dist between the segment and each outline segment.  However, if the
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
@@ -1582,7 +1594,7 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
     if( containsSingle( aPoint, aPolygonIndex, 1 ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
 
     SEG polygonEdge = *iterator;
     SEG::ecoord minDistance = polygonEdge.SquaredDistance( aPoint );
@@ -1601,7 +1613,8 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
 }
 
 
-SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int aPolygonIndex )
+SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment,
+                                                      int aPolygonIndex ) const
 {
     // We calculate the min dist between the segment and each outline segment.  However, if the
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
@@ -1610,9 +1623,9 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int a
     if( containsSingle( aSegment.A, aPolygonIndex, 1 ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
-    SEG              polygonEdge = *iterator;
-    SEG::ecoord      minDistance = polygonEdge.SquaredDistance( aSegment );
+    CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
+    SEG                    polygonEdge = *iterator;
+    SEG::ecoord            minDistance = polygonEdge.SquaredDistance( aSegment );
 
     for( iterator++; iterator && minDistance > 0; iterator++ )
     {
@@ -1629,7 +1642,7 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int a
 }
 
 
-SEG::ecoord SHAPE_POLY_SET::SquaredDistance( VECTOR2I aPoint )
+SEG::ecoord SHAPE_POLY_SET::SquaredDistance( VECTOR2I aPoint ) const
 {
     SEG::ecoord currentDistance;
     SEG::ecoord minDistance = SquaredDistanceToPolygon( aPoint, 0 );
@@ -1647,7 +1660,7 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistance( VECTOR2I aPoint )
 }
 
 
-SEG::ecoord SHAPE_POLY_SET::SquaredDistance( const SEG& aSegment )
+SEG::ecoord SHAPE_POLY_SET::SquaredDistance( const SEG& aSegment ) const
 {
     SEG::ecoord currentDistance;
     SEG::ecoord minDistance = SquaredDistanceToPolygon( aSegment, 0 );
@@ -1678,7 +1691,8 @@ bool SHAPE_POLY_SET::IsVertexInHole( int aGlobalIdx )
 }
 
 
-SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance, std::set<VECTOR2I>* aPreserveCorners )
+SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance,
+                                        std::set<VECTOR2I>* aPreserveCorners ) const
 {
     SHAPE_POLY_SET chamfered;
 
@@ -1690,7 +1704,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Chamfer( int aDistance, std::set<VECTOR2I>* aPres
 
 
 SHAPE_POLY_SET SHAPE_POLY_SET::Fillet( int aRadius, int aErrorMax,
-                                       std::set<VECTOR2I>* aPreserveCorners )
+                                       std::set<VECTOR2I>* aPreserveCorners ) const
 {
     SHAPE_POLY_SET filleted;
 
@@ -1703,14 +1717,28 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Fillet( int aRadius, int aErrorMax,
 
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::chamferFilletPolygon( CORNER_MODE aMode,
                                         unsigned int aDistance, int aIndex, int aErrorMax,
-                                        std::set<VECTOR2I>* aPreserveCorners )
+                                        std::set<VECTOR2I>* aPreserveCorners ) const
 {
-    // Null segments create serious issues in calculations. Remove them:
-    RemoveNullSegments();
-
-    SHAPE_POLY_SET::POLYGON currentPoly = Polygon( aIndex );
+    SHAPE_POLY_SET::POLYGON currentPoly;
     SHAPE_POLY_SET::POLYGON newPoly;
 
+    // Null segments create serious issues in calculations.  Remove them from a copy of the
+    // contours: this set may be shared with copies read by other threads.
+    for( const SHAPE_LINE_CHAIN& contour : CPolygon( aIndex ) )
+    {
+        SHAPE_LINE_CHAIN cleaned;
+
+        // Append() skips the repeated points
+        for( int ii = 0; ii < contour.PointCount(); ii++ )
+            cleaned.Append( contour.CPoint( ii ) );
+
+        if( cleaned.PointCount() > 1 && cleaned.CPoint( 0 ) == cleaned.CPoint( -1 ) )
+            cleaned.Remove( cleaned.PointCount() - 1 );
+
+        cleaned.SetClosed( contour.IsClosed() );
+        currentPoly.push_back( cleaned );
+    }
+
     // If the chamfering distance is zero, then the polygon remain intact.
     if( aDistance == 0 )
     {
@@ -1936,7 +1964,7 @@ void SHAPE_POLY_SET::CacheTriangulation()
 
     while( tmpSet.OutlineCount() > 0 )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
+        m_triangulatedPolys.push_back( std::make_shared<TRIANGULATED_POLYGON>() );
         PolygonTriangulation tess( *m_triangulatedPolys.back() );
 
         // If the tesselation fails, we re-fracture the polygon, which will
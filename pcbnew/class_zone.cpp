@@ -107,8 +107,7 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     SetHatchStyle( aOther.GetHatchStyle() );
     SetHatchPitch( aOther.GetHatchPitch() );
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.Append( aOther.m_FilledPolysList );
+    m_FilledPolysList = aOther.m_FilledPolysList;    // shared until one of them is refilled
     m_FillSegmList.clear();
     m_FillSegmList = aOther.m_FillSegmList;
 
@@ -158,7 +157,7 @@ void ZONE_CONTAINER::initDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone )
     m_PadConnection = aZone.m_PadConnection;
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
-    m_FilledPolysList.Append( aZone.m_FilledPolysList );
+    m_FilledPolysList = aZone.m_FilledPolysList;    // shared until one of them is refilled
     m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
 
     m_doNotAllowCopperPour = aZone.m_doNotAllowCopperPour;
@@ -491,7 +490,7 @@ bool ZONE_CONTAINER::HitTestCutout( const VECTOR2I& aRefPos, int* aOutlineIdx, i
     {
         for( int j = 0; j < m_Poly->HoleCount( i ); j++ )
         {
-            if( m_Poly->Hole( i, j ).PointInside( aRefPos ) )
+            if( m_Poly->CHole( i, j ).PointInside( aRefPos ) )
             {
                 if( aOutlineIdx )
                     *aOutlineIdx = i;
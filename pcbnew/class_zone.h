@@ -642,6 +642,11 @@ public:
         return m_RawPolysList;
     }
 
+    const SHAPE_POLY_SET& RawPolysList() const
+    {
+        return m_RawPolysList;
+    }
+
     wxString GetSelectMenuText( EDA_UNITS aUnits ) const override;
 
     BITMAP_DEF GetMenuImage() const override;
@@ -35,6 +35,9 @@
 #include <macros.h>
 #include <math/util.h>      // for KiROUND
 
+#include <algorithm>
+#include <unordered_set>
+
 
 /* This module contains out of line member functions for classes given in
  * collectors.h.  Those classes augment the functionality of class PCB_EDIT_FRAME.
@@ -564,6 +567,80 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
 }
 
 
+void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
+                                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                                 const KIGFX::VIEW* aView )
+{
+    Empty();        // empty the collection, primary criteria list
+    Empty2nd();     // empty the collection, secondary criteria list
+
+    SetGuide( &aGuide );
+    SetScanTypes( aScanList );
+    SetRefPos( aRefPos );
+
+    // Broad phase: the items whose view bounding box is near aRefPos.  The margin is the
+    // largest hit test accuracy used by Inspect() (for zone corners).
+    int   margin = 2 * KiROUND( 5 * aGuide.OnePixelInIU() ) + 1;
+    BOX2I area( VECTOR2I( aRefPos.x - margin, aRefPos.y - margin ),
+                VECTOR2I( 2 * margin, 2 * margin ) );
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> found;
+    aView->Query( area, found );
+
+    auto scanIndex = [aScanList]( const BOARD_ITEM* aCandidate ) -> int
+    {
+        for( int i = 0; aScanList[i] != EOT; i++ )
+        {
+            if( aScanList[i] == aCandidate->Type() )
+                return i;
+        }
+
+        return -1;
+    };
+
+    std::vector<BOARD_ITEM*>        candidates;
+    std::unordered_set<BOARD_ITEM*> seen;
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& pair : found )
+    {
+        // The view also holds items that are not board items, or are not in the board yet
+        BOARD_ITEM* candidate = dynamic_cast<BOARD_ITEM*>( pair.first );
+
+        if( !candidate || !seen.insert( candidate ).second || scanIndex( candidate ) < 0 )
+            continue;
+
+        BOARD_ITEM* parent = candidate->GetParent();
+
+        while( parent && parent != aItem )
+            parent = parent->GetParent();
+
+        if( parent )
+            candidates.push_back( candidate );
+    }
+
+    std::stable_sort( candidates.begin(), candidates.end(),
+            [&scanIndex]( const BOARD_ITEM* aA, const BOARD_ITEM* aB )
+            {
+                return scanIndex( aA ) < scanIndex( aB );
+            } );
+
+    for( BOARD_ITEM* candidate : candidates )
+    {
+        if( m_inspector( candidate, nullptr ) == SEARCH_RESULT::QUIT )
+            break;
+    }
+
+    // record the length of the primary list before concatenating on to it.
+    m_PrimaryLength = m_List.size();
+
+    // append 2nd list onto end of the first list
+    for( unsigned i = 0;  i<m_List2nd.size();  ++i )
+        Append( m_List2nd[i] );
+
+    Empty2nd();
+}
+
+
 SEARCH_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the
@@ -375,6 +375,22 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
                  const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+    /**
+     * Collect the items of \a aItem hit at \a aRefPos, as the Collect() above, but only test
+     * the items found near \a aRefPos in the spatial index of \a aView, instead of scanning
+     * every item of \a aItem.  Items on layers hidden in \a aView are not collected.
+     *
+     * The collected items are in the priority order of \a aScanList.
+     *
+     * @param aItem A BOARD_ITEM whose children are to be collected, usually the BOARD.
+     * @param aScanList A list of KICAD_Ts with a terminating EOT.
+     * @param aRefPos A wxPoint to use in hit-testing.
+     * @param aGuide The COLLECTORS_GUIDE to use in collecting items.
+     * @param aView The VIEW showing \a aItem.
+     */
+    void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[], const wxPoint& aRefPos,
+                  const COLLECTORS_GUIDE& aGuide, const KIGFX::VIEW* aView );
 };
 
 
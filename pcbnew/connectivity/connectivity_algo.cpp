@@ -523,30 +523,17 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE_CONTAINER* aZone, std
     if( aZone->GetFilledPolysList().IsEmpty() )
         return;
 
-    aIslands.clear();
+    std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> zones;
+    zones.emplace_back( aZone );
 
-    Remove( aZone );
-    Add( aZone );
+    FindIsolatedCopperIslands( zones );
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
-
-    for( const auto& cluster : m_connClusters )
-    {
-        if( cluster->Contains( aZone ) && cluster->IsOrphaned() )
-        {
-            for( auto z : *cluster )
-            {
-                if( z->Parent() == aZone )
-                {
-                    aIslands.push_back( static_cast<CN_ZONE*>(z)->SubpolyIndex() );
-                }
-            }
-        }
-    }
+    aIslands = std::move( zones[0].m_islands );
 
     wxLogTrace( "CN", "Found %u isolated islands\n", (unsigned)aIslands.size() );
 }
 
+
 void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones )
 {
     for ( auto& z : aZones )
@@ -558,25 +545,81 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLAT
             Add( z.m_zone );
     }
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
+    // Only the re-added zone items are dirty, so this only searches their neighbours
+    if( m_itemList.IsDirty() )
+        searchConnections();
+
+    // Rather than splitting the whole board into clusters, walk the items connected to each
+    // zone subpolygon, in the zone net, until a pad is found.  The result is recorded for
+    // every item walked, so other subpolygons reaching them stop there.
+    enum ISLAND_STATE { IS_PENDING, IS_CONNECTED, IS_ISOLATED };
 
-    for ( auto& zone : aZones )
+    std::unordered_map<CN_ITEM*, ISLAND_STATE> states;
+    std::vector<CN_ITEM*>                      walked;
+    std::deque<CN_ITEM*>                       Q;
+
+    for( auto& zone : aZones )
     {
-        if( zone.m_zone->GetFilledPolysList().IsEmpty() )
+        // Zones without a net never have islands
+        if( zone.m_zone->GetFilledPolysList().IsEmpty() || zone.m_zone->GetNetCode() <= 0 )
             continue;
 
-        for( const auto& cluster : m_connClusters )
+        for( CN_ITEM* zitem : m_itemMap[zone.m_zone].GetItems() )
         {
-            if( cluster->Contains( zone.m_zone ) && cluster->IsOrphaned() )
+            if( !zitem->Valid() || states.count( zitem ) )
+                continue;
+
+            bool connected = false;
+
+            walked.clear();
+            Q.clear();
+
+            states[zitem] = IS_PENDING;
+            walked.push_back( zitem );
+            Q.push_back( zitem );
+
+            while( !Q.empty() && !connected )
             {
-                for( auto z : *cluster )
+                CN_ITEM* current = Q.front();
+                Q.pop_front();
+
+                if( current->Parent()->Type() == PCB_PAD_T )
                 {
-                    if( z->Parent() == zone.m_zone )
+                    connected = true;
+                    break;
+                }
+
+                for( CN_ITEM* n : current->ConnectedItems() )
+                {
+                    if( n->Net() != zitem->Net() || !n->Valid() )
+                        continue;
+
+                    auto state = states.find( n );
+
+                    if( state == states.end() )
+                    {
+                        states[n] = IS_PENDING;
+                        walked.push_back( n );
+                        Q.push_back( n );
+                    }
+                    else if( state->second == IS_CONNECTED )
                     {
-                        zone.m_islands.push_back( static_cast<CN_ZONE*>(z)->SubpolyIndex() );
+                        connected = true;
+                        break;
                     }
                 }
             }
+
+            for( CN_ITEM* item : walked )
+                states[item] = connected ? IS_CONNECTED : IS_ISOLATED;
+        }
+
+        for( CN_ITEM* zitem : m_itemMap[zone.m_zone].GetItems() )
+        {
+            auto state = states.find( zitem );
+
+            if( state != states.end() && state->second == IS_ISOLATED )
+                zone.m_islands.push_back( static_cast<CN_ZONE*>( zitem )->SubpolyIndex() );
         }
     }
 }
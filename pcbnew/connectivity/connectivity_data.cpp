@@ -35,6 +35,257 @@
 #include <connectivity/connectivity_algo.h>
 #include <ratsnest_data.h>
 
+
+/**
+ * The state of an item moved with the dynamic ratsnest, used to find out whether the item
+ * has only been translated since the dynamic ratsnest session was built.
+ */
+struct RN_DYNAMIC_ITEM_STATE
+{
+    BOARD_ITEM* item;
+    VECTOR2I    a;         ///< reference point of the item
+    VECTOR2I    b;         ///< second reference point, for items that can rotate around a
+    double      angle;
+    LSET        layers;
+
+    RN_DYNAMIC_ITEM_STATE( BOARD_ITEM* aItem ) :
+            item( aItem ),
+            angle( 0.0 ),
+            layers( aItem->GetLayerSet() )
+    {
+        switch( aItem->Type() )
+        {
+        case PCB_PAD_T:
+            a = static_cast<D_PAD*>( aItem )->ShapePos();
+            b = a;
+            angle = static_cast<D_PAD*>( aItem )->GetOrientation();
+            break;
+
+        case PCB_MODULE_T:
+            a = aItem->GetPosition();
+            b = a;
+            angle = static_cast<MODULE*>( aItem )->GetOrientation();
+            break;
+
+        case PCB_TRACE_T:
+        case PCB_ARC_T:
+        case PCB_VIA_T:
+            a = static_cast<TRACK*>( aItem )->GetStart();
+            b = static_cast<TRACK*>( aItem )->GetEnd();
+            break;
+
+        case PCB_ZONE_AREA_T:
+        {
+            ZONE_CONTAINER* zone = static_cast<ZONE_CONTAINER*>( aItem );
+
+            a = VECTOR2I( aItem->GetPosition() );
+
+            if( zone->GetNumCorners() > 0 )
+                a = zone->GetCornerPosition( 0 );
+
+            b = zone->GetNumCorners() > 1 ? zone->GetCornerPosition( 1 ) : a;
+            break;
+        }
+
+        default:
+            a = aItem->GetPosition();
+            b = a;
+            break;
+        }
+    }
+};
+
+
+/**
+ * The part of the dynamic ratsnest that does not change while a set of items is dragged:
+ * the connectivity of the dragged items, their anchors and the anchors of the static
+ * items of their nets, sorted for nearest neighbor searches.
+ */
+class RN_DYNAMIC_SESSION
+{
+public:
+    RN_DYNAMIC_SESSION( const std::vector<BOARD_ITEM*>& aItems,
+                        const std::vector<RN_NET*>& aStaticNets ) :
+            m_connectivity( aItems )
+    {
+        for( BOARD_ITEM* item : aItems )
+            m_initialStates.emplace_back( item );
+
+        for( unsigned int nc = 1; nc < aStaticNets.size(); nc++ )
+        {
+            RN_NET* dynNet = m_connectivity.GetRatsnestForNet( nc );
+
+            if( !dynNet )
+                break;
+
+            if( dynNet->GetNodeCount() == 0 )
+                continue;
+
+            DYNAMIC_NET net;
+            net.netCode = nc;
+
+            for( const CN_ANCHOR_PTR& node : dynNet->GetAllNodes() )
+                net.movingAnchors.push_back( node->Pos() );
+
+            for( const CN_ANCHOR_PTR& node : aStaticNets[nc]->GetAllNodes() )
+            {
+                if( !node->GetNoLine() )
+                    net.staticAnchors.push_back( node->Pos() );
+            }
+
+            if( net.staticAnchors.empty() )
+                continue;
+
+            std::sort( net.staticAnchors.begin(), net.staticAnchors.end(),
+                    []( const VECTOR2I& aA, const VECTOR2I& aB )
+                    {
+                        return aA.x < aB.x;
+                    } );
+
+            m_nets.push_back( std::move( net ) );
+        }
+
+        for( int nc = 0; m_connectivity.GetRatsnestForNet( nc ); nc++ )
+        {
+            for( const CN_EDGE& edge : m_connectivity.GetRatsnestForNet( nc )->GetUnconnected() )
+                m_internalEdges.push_back( { edge.GetSourceNode()->Pos(),
+                                             edge.GetTargetNode()->Pos() } );
+        }
+    }
+
+    /**
+     * Find whether aItems are the items of the session, only translated since the session
+     * was built.
+     * @param aTranslation is set to the translation.
+     */
+    bool IsTranslationOf( const std::vector<BOARD_ITEM*>& aItems, VECTOR2I& aTranslation ) const
+    {
+        if( aItems.size() != m_initialStates.size() )
+            return false;
+
+        for( size_t i = 0; i < aItems.size(); i++ )
+        {
+            const RN_DYNAMIC_ITEM_STATE& initial = m_initialStates[i];
+
+            if( aItems[i] != initial.item )
+                return false;
+
+            RN_DYNAMIC_ITEM_STATE current( aItems[i] );
+
+            if( current.angle != initial.angle || current.layers != initial.layers )
+                return false;
+
+            if( i == 0 )
+                aTranslation = current.a - initial.a;
+
+            if( current.a - initial.a != aTranslation || current.b - initial.b != aTranslation )
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Compute the dynamic ratsnest of the session items translated by aTranslation.
+     */
+    void Compute( const VECTOR2I& aTranslation, std::vector<RN_DYNAMIC_LINE>& aLines ) const
+    {
+        for( const DYNAMIC_NET& net : m_nets )
+        {
+            VECTOR2I::extended_type bestDist = VECTOR2I::ECOORD_MAX;
+            VECTOR2I                bestStatic, bestMoving;
+
+            for( const VECTOR2I& anchor : net.movingAnchors )
+            {
+                VECTOR2I moving = anchor + aTranslation;
+
+                if( nearestStaticAnchor( net, moving, bestDist, bestStatic ) )
+                    bestMoving = moving;
+            }
+
+            if( bestDist < VECTOR2I::ECOORD_MAX )
+            {
+                RN_DYNAMIC_LINE l;
+                l.a = bestStatic;
+                l.b = bestMoving;
+                l.netCode = net.netCode;
+
+                aLines.push_back( l );
+            }
+        }
+
+        for( const std::pair<VECTOR2I, VECTOR2I>& edge : m_internalEdges )
+        {
+            RN_DYNAMIC_LINE l;
+            l.a = edge.first + aTranslation;
+            l.b = edge.second + aTranslation;
+            l.netCode = 0;
+
+            aLines.push_back( l );
+        }
+    }
+
+private:
+    struct DYNAMIC_NET
+    {
+        int                   netCode;
+        std::vector<VECTOR2I> movingAnchors;    ///< at the positions the session was built at
+        std::vector<VECTOR2I> staticAnchors;    ///< sorted by X coordinate
+    };
+
+    /**
+     * Search the static anchors of aNet for one closer to aPos than aBestDist.  The anchors
+     * are scanned from the X coordinate of aPos outwards, until the X distance alone is
+     * larger than the best distance found.
+     * @return true if a closer anchor was found, in which case aBestDist and aBest are updated.
+     */
+    static bool nearestStaticAnchor( const DYNAMIC_NET& aNet, const VECTOR2I& aPos,
+                                     VECTOR2I::extended_type& aBestDist, VECTOR2I& aBest )
+    {
+        const std::vector<VECTOR2I>& anchors = aNet.staticAnchors;
+        bool                         found = false;
+
+        auto start = std::lower_bound( anchors.begin(), anchors.end(), aPos,
+                []( const VECTOR2I& aA, const VECTOR2I& aB )
+                {
+                    return aA.x < aB.x;
+                } );
+
+        auto check = [&]( const VECTOR2I& aAnchor ) -> bool
+        {
+            VECTOR2I::extended_type dx = (VECTOR2I::extended_type) aAnchor.x - aPos.x;
+
+            if( dx * dx >= aBestDist )
+                return false;
+
+            VECTOR2I::extended_type dist = ( aAnchor - aPos ).SquaredEuclideanNorm();
+
+            if( dist < aBestDist )
+            {
+                aBestDist = dist;
+                aBest = aAnchor;
+                found = true;
+            }
+
+            return true;
+        };
+
+        for( auto it = start; it != anchors.end() && check( *it ); ++it )
+            ;
+
+        for( auto it = start; it != anchors.begin() && check( *( it - 1 ) ); --it )
+            ;
+
+        return found;
+    }
+
+    CONNECTIVITY_DATA                          m_connectivity;
+    std::vector<RN_DYNAMIC_ITEM_STATE>         m_initialStates;
+    std::vector<DYNAMIC_NET>                   m_nets;
+    std::vector<std::pair<VECTOR2I, VECTOR2I>> m_internalEdges;
+};
+
+
 CONNECTIVITY_DATA::CONNECTIVITY_DATA()
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
@@ -149,6 +400,9 @@ void CONNECTIVITY_DATA::addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& a
 
 void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
+    // The static anchors of a dynamic ratsnest session may be outdated
+    m_dynamicSession.reset();
+
     m_connAlgo->PropagateNets( aCommit );
 
     int lastNet = m_connAlgo->NetCount();
@@ -254,57 +508,24 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
         return ;
     }
 
-    CONNECTIVITY_DATA connData( aItems );
-    BlockRatsnestItems( aItems );
+    VECTOR2I translation;
 
-    for( unsigned int nc = 1; nc < connData.m_nets.size(); nc++ )
+    if( !m_dynamicSession || !m_dynamicSession->IsTranslationOf( aItems, translation ) )
     {
-        auto dynNet = connData.m_nets[nc];
-
-        if( dynNet->GetNodeCount() != 0 )
-        {
-            auto ourNet = m_nets[nc];
-            CN_ANCHOR_PTR nodeA, nodeB;
+        // The moved items must not be found as static anchors
+        BlockRatsnestItems( aItems );
 
-            if( ourNet->NearestBicoloredPair( *dynNet, nodeA, nodeB ) )
-            {
-                RN_DYNAMIC_LINE l;
-                l.a = nodeA->Pos();
-                l.b = nodeB->Pos();
-                l.netCode = nc;
-
-                m_dynamicRatsnest.push_back( l );
-            }
-        }
+        m_dynamicSession.reset( new RN_DYNAMIC_SESSION( aItems, m_nets ) );
+        translation = VECTOR2I( 0, 0 );
     }
 
-    for( auto net : connData.m_nets )
-    {
-        if( !net )
-            continue;
-
-        const auto& edges = net->GetUnconnected();
-
-        if( edges.empty() )
-            continue;
-
-        for( const auto& edge : edges )
-        {
-            const auto& nodeA   = edge.GetSourceNode();
-            const auto& nodeB   = edge.GetTargetNode();
-            RN_DYNAMIC_LINE l;
-
-            l.a = nodeA->Pos();
-            l.b = nodeB->Pos();
-            l.netCode = 0;
-            m_dynamicRatsnest.push_back( l );
-        }
-    }
+    m_dynamicSession->Compute( translation, m_dynamicRatsnest );
 }
 
 
 void CONNECTIVITY_DATA::ClearDynamicRatsnest()
 {
+    m_dynamicSession.reset();
     m_connAlgo->ForEachAnchor( [] ( CN_ANCHOR& anchor ) { anchor.SetNoLine( false ); } );
     HideDynamicRatsnest();
 }
@@ -345,6 +566,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount() const
 
 void CONNECTIVITY_DATA::Clear()
 {
+    m_dynamicSession.reset();
+
     for( auto net : m_nets )
         delete net;
 
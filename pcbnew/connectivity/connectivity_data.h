@@ -52,6 +52,7 @@ class TRACK;
 class D_PAD;
 class MODULE;
 class PROGRESS_REPORTER;
+class RN_DYNAMIC_SESSION;
 
 struct CN_DISJOINT_NET_ENTRY
 {
@@ -201,6 +202,10 @@ public:
      * Function ComputeDynamicRatsnest()
      * Calculates the temporary dynamic ratsnest (i.e. the ratsnest lines that)
      * for the set of items aItems.
+     *
+     * The connectivity of aItems and the anchors of the other items are kept between calls:
+     * as long as aItems are the same items, only translated since the previous call, the
+     * ratsnest is updated from the translation without rebuilding them.
      */
     void ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems );
 
@@ -260,6 +265,9 @@ private:
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
     std::vector<RN_NET*> m_nets;
 
+    ///> The items of the last dynamic ratsnest and their connectivity
+    std::unique_ptr<RN_DYNAMIC_SESSION> m_dynamicSession;
+
     PROGRESS_REPORTER* m_progressReporter;
 
     std::mutex m_lock;
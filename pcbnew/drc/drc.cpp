@@ -1449,10 +1449,10 @@ const int EPSILON = Mils2iu( 5 );
 
 wxPoint DRC::GetLocation( TRACK* aTrack, ZONE_CONTAINER* aConflictZone )
 {
-    SHAPE_POLY_SET* conflictOutline;
+    const SHAPE_POLY_SET* conflictOutline;
 
     if( aConflictZone->IsFilled() )
-        conflictOutline = const_cast<SHAPE_POLY_SET*>( &aConflictZone->GetFilledPolysList() );
+        conflictOutline = &aConflictZone->GetFilledPolysList();
     else
         conflictOutline = aConflictZone->Outline();
 
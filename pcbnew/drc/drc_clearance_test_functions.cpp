@@ -573,7 +573,7 @@ void DRC::doTrackDrc( BOARD_COMMIT& aCommit, TRACK* aRefSeg, TRACKS::iterator aS
             int             minClearance = aRefSeg->GetClearance( zone, &m_clearanceSource );
             int             widths = refSegWidth / 2;
             int             center2centerAllowed = minClearance + widths;
-            SHAPE_POLY_SET* outline = const_cast<SHAPE_POLY_SET*>( &zone->GetFilledPolysList() );
+            const SHAPE_POLY_SET* outline = &zone->GetFilledPolysList();
 
             SEG::ecoord     center2center_squared = outline->SquaredDistance( testSeg );
 
@@ -24,10 +24,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <cmath>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <wx/dir.h>
 
@@ -71,6 +77,7 @@ static double BOARD_SCALE;          // scaling from mm to desired VRML world sca
 static const int PRECISION = 6;     // legacy precision factor (now set to 6)
 static wxString SUBDIR_3D;          // legacy 3D subdirectory
 static wxString PROJ_DIR;           // project directory
+static std::map<wxString, std::string> INLINE_DEFS;    // DEF names of the inlined 3D models
 
 struct VRML_COLOR
 {
@@ -420,144 +427,145 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
 }
 
 
+/**
+ * A board layer to tesselate and output.
+ *
+ * VRML_LAYER::Tesselate() renumbers the vertices of the holes layer it is given, so the
+ * layers sharing the board holes could only be tesselated and output one after the other.
+ * Each layer gets its own copy of the holes instead, to be tesselated (and formatted, for
+ * inline output) in parallel with the other ones.
+ */
+struct VRML_LAYER_JOB
+{
+    VRML_LAYER*                 m_layer;
+    VRML_LAYER*                 m_holes;        // holes to cut, NULL for the plated holes
+    std::unique_ptr<VRML_LAYER> m_holesCopy;    // owns m_holes when it is a copy
+    VRML_COLOR_INDEX            m_color;
+    bool                        m_plane;        // a plane at m_topZ, else a shell
+    bool                        m_top;          // the plane is seen from above
+    double                      m_topZ;
+    double                      m_bottomZ;
+    std::string                 m_text;         // triangle bag, for inline output
+};
+
+
 static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     const char* aFileName, OSTREAM* aOutputFile )
 {
-    // VRML_LAYER board;
-    aModel.m_board.Tesselate( &aModel.m_holes );
     double brdz = aModel.m_brd_thickness / 2.0
                   - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * BOARD_SCALE;
+    double artz = Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE;
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_PCB ),
-                            &aModel.m_board, false, false, brdz, -brdz );
-    }
-    else
-    {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_PCB, &aModel.m_board, brdz, -brdz );
-    }
+    std::vector<VRML_LAYER_JOB> jobs;
 
-    if( aModel.m_plainPCB )
+    auto addJob = [&]( VRML_LAYER& aLayer, bool aCutHoles, VRML_COLOR_INDEX aColor, bool aPlane,
+                       bool aTop, double aTopZ, double aBottomZ )
     {
-        if( !USE_INLINES )
-            S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), USE_DEFS, true );
+        jobs.emplace_back();
 
-        return;
-    }
+        VRML_LAYER_JOB& job = jobs.back();
+        job.m_layer = &aLayer;
+        job.m_holes = aCutHoles ? &aModel.m_holes : NULL;
+        job.m_color = aColor;
+        job.m_plane = aPlane;
+        job.m_top = aTop;
+        job.m_topZ = aTopZ;
+        job.m_bottomZ = aBottomZ;
+    };
 
-    // VRML_LAYER m_top_copper;
-    aModel.m_top_copper.Tesselate( &aModel.m_holes );
+    // Output order, which is also the order of the original serial export
+    addJob( aModel.m_board, true, VRML_COLOR_PCB, false, false, brdz, -brdz );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
-                           &aModel.m_top_copper, true, true,
-                           aModel.GetLayerZ( F_Cu ), 0 );
-    }
-    else
+    if( !aModel.m_plainPCB )
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_top_copper,
-                           aModel.GetLayerZ( F_Cu ), true );
+        double topZ = aModel.GetLayerZ( F_Cu );
+        double botZ = aModel.GetLayerZ( B_Cu );
+
+        addJob( aModel.m_top_copper, true, VRML_COLOR_TRACK, true, true, topZ, 0 );
+        addJob( aModel.m_top_tin, true, VRML_COLOR_TIN, true, true, topZ + artz, 0 );
+        addJob( aModel.m_bot_copper, true, VRML_COLOR_TRACK, true, false, botZ, 0 );
+        addJob( aModel.m_bot_tin, true, VRML_COLOR_TIN, true, false, botZ - artz, 0 );
+        addJob( aModel.m_plated_holes, false, VRML_COLOR_TIN, false, false, topZ + artz,
+                botZ - artz );
+        addJob( aModel.m_top_silk, true, VRML_COLOR_SILK, true, true,
+                aModel.GetLayerZ( F_SilkS ), 0 );
+        addJob( aModel.m_bot_silk, true, VRML_COLOR_SILK, true, false,
+                aModel.GetLayerZ( B_SilkS ), 0 );
+
+        // The board keeps the original holes, the other layers work on copies made before
+        // any tesselation renumbers them
+        for( size_t i = 1; i < jobs.size(); ++i )
+        {
+            if( !jobs[i].m_holes )
+                continue;
+
+            jobs[i].m_holesCopy.reset( new VRML_LAYER );
+            jobs[i].m_holesCopy->AppendContours( aModel.m_holes );
+            jobs[i].m_holes = jobs[i].m_holesCopy.get();
+        }
     }
 
-    // VRML_LAYER m_top_tin;
-    aModel.m_top_tin.Tesselate( &aModel.m_holes );
+    std::atomic<size_t> nextItem( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), jobs.size() );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_top_tin, true, true,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            0 );
-    }
-    else
+    auto tesselate_lambda = [&]() -> size_t
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_top_tin,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           true );
-    }
+        size_t num = 0;
 
-    // VRML_LAYER m_bot_copper;
-    aModel.m_bot_copper.Tesselate( &aModel.m_holes );
+        for( size_t i = nextItem++; i < jobs.size(); i = nextItem++ )
+        {
+            VRML_LAYER_JOB& job = jobs[i];
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
-                            &aModel.m_bot_copper, true, false,
-                            aModel.GetLayerZ( B_Cu ), 0 );
-    }
-    else
-    {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_bot_copper,
-                           aModel.GetLayerZ( B_Cu ), false );
-    }
+            if( job.m_holes )
+                job.m_layer->Tesselate( job.m_holes );
+            else
+                job.m_layer->Tesselate( NULL, true );
 
-    // VRML_LAYER m_bot_tin;
-    aModel.m_bot_tin.Tesselate( &aModel.m_holes );
+            if( USE_INLINES )
+            {
+                std::ostringstream text;
+                text.imbue( std::locale::classic() );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_bot_tin, true, false,
-                            aModel.GetLayerZ( B_Cu )
-                            - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            0 );
-    }
-    else
-    {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_bot_tin,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           false );
-    }
+                write_triangle_bag( text, aModel.GetColor( job.m_color ), job.m_layer,
+                                    job.m_plane, job.m_top, job.m_topZ, job.m_bottomZ );
 
-    // VRML_LAYER PTH;
-    aModel.m_plated_holes.Tesselate( NULL, true );
+                job.m_text = text.str();
+            }
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
-                            &aModel.m_plated_holes, false, false,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
-    }
-    else
-    {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_plated_holes,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
-    }
+            num++;
+        }
 
-    // VRML_LAYER m_top_silk;
-    aModel.m_top_silk.Tesselate( &aModel.m_holes );
+        return num;
+    };
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_top_silk,
-                            true, true, aModel.GetLayerZ( F_SilkS ), 0 );
-    }
+    if( parallelThreadCount <= 1 )
+        tesselate_lambda();
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_top_silk,
-                           aModel.GetLayerZ( F_SilkS ), true );
-    }
-
-    // VRML_LAYER m_bot_silk;
-    aModel.m_bot_silk.Tesselate( &aModel.m_holes );
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, tesselate_lambda );
 
-    if( USE_INLINES )
-    {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_bot_silk,
-                            true, false, aModel.GetLayerZ( B_SilkS ), 0 );
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].get();
     }
-    else
+
+    // The scene graph is not thread safe, it is built here in the output order
+    for( VRML_LAYER_JOB& job : jobs )
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_bot_silk,
-                           aModel.GetLayerZ( B_SilkS ), false );
+        if( USE_INLINES )
+            *aOutputFile << job.m_text;
+        else if( job.m_plane )
+            create_vrml_plane( aModel.m_OutputPCB, job.m_color, job.m_layer, job.m_topZ,
+                               job.m_top );
+        else
+            create_vrml_shell( aModel.m_OutputPCB, job.m_color, job.m_layer, job.m_topZ,
+                               job.m_bottomZ );
     }
 
     if( !USE_INLINES )
-        S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), true, true );
+        S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), USE_DEFS, true );
 }
 
 
@@ -1472,6 +1480,23 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             dstFile.SetName( srcFile.GetName() );
             dstFile.SetExt( "wrl"  );
 
+            wxFileName urlFile = dstFile;
+
+            if( USE_RELPATH )
+            {
+                wxFileName tmp = dstFile;
+                tmp.SetExt( "" );
+                tmp.SetName( "" );
+                tmp.RemoveLastDir();
+                urlFile.MakeRelativeTo( tmp.GetPath() );
+            }
+
+            wxString fn = urlFile.GetFullPath();
+            fn.Replace( "\\", "/" );
+
+            // A model inlined before is already copied, and is referenced by its DEF name
+            auto def = INLINE_DEFS.find( fn );
+
             // copy the file if necessary
             wxDateTime srcModTime = srcFile.GetModificationTime();
             wxDateTime destModTime = srcModTime;
@@ -1481,7 +1506,7 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             if( dstFile.FileExists() )
                 destModTime = dstFile.GetModificationTime();
 
-            if( srcModTime != destModTime )
+            if( def == INLINE_DEFS.end() && srcModTime != destModTime )
             {
                 wxLogDebug( "Copying 3D model %s to %s.",
                             GetChars( srcFile.GetFullPath() ),
@@ -1495,12 +1520,18 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
                 if( fileExt == "wrl" )
                 {
                     if( !wxCopyFile( srcFile.GetFullPath(), dstFile.GetFullPath() ) )
+                    {
+                        ++sM;
                         continue;
+                    }
                 }
                 else
                 {
                     if( !S3D::WriteVRML( dstFile.GetFullPath().ToUTF8(), true, mod3d, USE_DEFS, true ) )
+                    {
+                        ++sM;
                         continue;
+                    }
                 }
             }
 
@@ -1523,20 +1554,19 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             (*aOutputFile) << sM->m_Scale.y << " ";
             (*aOutputFile) << sM->m_Scale.z << "\n";
 
-            (*aOutputFile) << "  children [\n    Inline {\n      url \"";
-
-            if( USE_RELPATH )
+            if( def != INLINE_DEFS.end() )
             {
-                wxFileName tmp = dstFile;
-                tmp.SetExt( "" );
-                tmp.SetName( "" );
-                tmp.RemoveLastDir();
-                dstFile.MakeRelativeTo( tmp.GetPath() );
+                (*aOutputFile) << "  children [\n    USE " << def->second << " ]\n";
+            }
+            else
+            {
+                std::string name = "MODEL_" + std::to_string( INLINE_DEFS.size() );
+                INLINE_DEFS[fn] = name;
+
+                (*aOutputFile) << "  children [\n    DEF " << name << " Inline {\n      url \"";
+                (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
             }
 
-            wxString fn = dstFile.GetFullPath();
-            fn.Replace( "\\", "/" );
-            (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
             (*aOutputFile) << "  }\n";
         }
         else
@@ -1582,6 +1612,7 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
     cache = Prj().Get3DCacheManager();
     PROJ_DIR = Prj().GetProjectPath();
     SUBDIR_3D = a3D_Subdir;
+    INLINE_DEFS.clear();
     MODEL_VRML model3d;
     model_vrml = &model3d;
     model3d.SetScale( aMMtoWRMLunit );
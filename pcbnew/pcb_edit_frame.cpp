@@ -208,6 +208,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
     SetScreen( new PCB_SCREEN( GetPageSettings().GetSizeIU() ) );
     GetScreen()->SetMaxUndoItems( m_UndoRedoCountMax );
+    GetScreen()->SetMaxUndoMemory( m_UndoRedoMemoryMax );
 
     // PCB drawings start in the upper left corner.
     GetScreen()->m_Center = false;
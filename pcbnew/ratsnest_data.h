@@ -122,6 +122,11 @@ public:
      */
     std::list<CN_ANCHOR_PTR> GetNodes( const BOARD_CONNECTED_ITEM* aItem ) const;
 
+    const std::vector<CN_ANCHOR_PTR>& GetAllNodes() const
+    {
+        return m_nodes;
+    }
+
     const std::vector<CN_EDGE>& GetEdges() const
     {
         return m_rnEdges;
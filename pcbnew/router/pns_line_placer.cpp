@@ -25,6 +25,7 @@
 #include "pns_debug_decorator.h"
 #include "pns_line_placer.h"
 #include "pns_node.h"
+#include "pns_optimizer.h"
 #include "pns_router.h"
 #include "pns_shove.h"
 #include "pns_topology.h"
@@ -389,14 +390,14 @@ VECTOR2I closestProjectedPoint( const SHAPE_LINE_CHAIN& line, const VECTOR2I& p
 }
 
 
-bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
+LINE_PLACER::WALK_CANDIDATE LINE_PLACER::walkaroundCandidate( const VECTOR2I& aP,
+                                                              bool aInvertPosture )
 {
+    WALK_CANDIDATE candidate;
     LINE initTrack( m_head );
-    LINE walkFull( m_head );
-    int effort = 0;
-    bool rv = true, viaOk;
 
-    viaOk = buildInitialLine( aP, initTrack );
+    candidate.m_line = m_head;
+    candidate.m_viaOk = buildInitialLine( aP, initTrack, aInvertPosture );
 
     WALKAROUND walkaround( m_currentNode, Router() );
 
@@ -406,7 +407,6 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
     walkaround.SetIterationLimit( Settings().WalkaroundIterationLimit() );
 
     WALKAROUND::RESULT wr = walkaround.Route( initTrack );
-    //WALKAROUND::WALKAROUND_STATUS wf = walkaround.Route( initTrack, walkFull, false );
 
     auto l_cw = wr.lineCw.CLine();
     auto l_ccw = wr.lineCcw.CLine();
@@ -423,17 +423,56 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
         l_cw = l_cw.Slice( 0, idx_cw );
         l_ccw = l_ccw.Slice( 0, idx_ccw );
 
-        //Dbg()->AddLine( wr.lineCw.CLine(), 3, 40000 );
-
-        //Dbg()->AddPoint( p_cw, 4 );
-        //Dbg()->AddPoint( p_ccw, 5 );
-
         Dbg()->AddLine( wr.lineCw.CLine(), 4, 1000 );
         Dbg()->AddLine( wr.lineCcw.CLine(), 5, 1000 );
 
     }
 
-    walkFull.SetShape( l_ccw.Length() < l_cw.Length() ? l_ccw : l_cw );
+    candidate.m_line.SetShape( l_ccw.Length() < l_cw.Length() ? l_ccw : l_cw );
+    candidate.m_done = ( wr.statusCw == WALKAROUND::DONE || wr.statusCcw == WALKAROUND::DONE );
+    candidate.m_stuck = ( wr.statusCw == WALKAROUND::STUCK || wr.statusCcw == WALKAROUND::STUCK );
+
+    return candidate;
+}
+
+
+bool LINE_PLACER::WALK_CANDIDATE::IsBetterThan( const WALK_CANDIDATE& aOther ) const
+{
+    if( m_done != aOther.m_done )
+        return m_done;
+
+    if( m_stuck != aOther.m_stuck )
+        return !m_stuck;
+
+    LINE self( m_line ), other( aOther.m_line );
+    COST_ESTIMATOR selfCost, otherCost;
+
+    selfCost.Add( self );
+    otherCost.Add( other );
+
+    return otherCost.IsBetter( selfCost, 1.0, 1.0 );
+}
+
+
+bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
+{
+    int effort = 0;
+    bool rv = true;
+
+    WALK_CANDIDATE best = walkaroundCandidate( aP, false );
+
+    // The walkaround couldn't reach the cursor with the current posture. Speculatively try
+    // the opposite posture of the initial trace as well and keep the cheaper of both routes
+    // (by COST_ESTIMATOR), instead of settling for the first one.
+    if( !best.m_done && !m_orthoMode )
+    {
+        WALK_CANDIDATE alt = walkaroundCandidate( aP, true );
+
+        if( alt.IsBetterThan( best ) )
+            best = alt;
+    }
+
+    LINE& walkFull = best.m_line;
 
     Dbg()->AddLine( walkFull.CLine(), 2, 100000, "walk-full" );
 
@@ -452,12 +491,12 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
     if( Settings().SmartPads() )
         effort |= OPTIMIZER::SMART_PADS;
 
-    if( wr.statusCw == WALKAROUND::STUCK || wr.statusCcw == WALKAROUND::STUCK )
+    if( best.m_stuck )
     {
         walkFull = walkFull.ClipToNearestObstacle( m_currentNode );
         rv = true;
     }
-    else if( m_placingVia && viaOk )
+    else if( m_placingVia && best.m_viaOk )
     {
         walkFull.AppendVia( makeVia( walkFull.CPoint( -1 ) ) );
     }
@@ -374,6 +374,22 @@ private:
     bool rhStopAtNearestObstacle( const VECTOR2I& aP, LINE& aNewHead );
 
 
+    ///> a single speculative walkaround result, see rhWalkOnly()
+    struct WALK_CANDIDATE
+    {
+        ///> true if this candidate should be preferred over aOther
+        bool IsBetterThan( const WALK_CANDIDATE& aOther ) const;
+
+        LINE m_line;
+        bool m_viaOk = false;
+        bool m_done = false;    ///> walkaround reached the cursor in at least one direction
+        bool m_stuck = false;   ///> walkaround got stuck in at least one direction
+    };
+
+    ///> walks around the obstacles for a given posture of the initial trace and picks the
+    ///  shorter of the CW/CCW results
+    WALK_CANDIDATE walkaroundCandidate( const VECTOR2I& aP, bool aInvertPosture );
+
     ///> route step, walkaround mode
     bool rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead);
 
@@ -585,6 +585,111 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
 
 
+/**
+ * Estimate the memory used by the vertices and the triangulation of a polygon set.
+ * Copies share their polygons until one of them is modified: each set sharing them is
+ * charged its part, so that shared polygons are counted once in all.
+ */
+static size_t polySetMemoryUsage( const SHAPE_POLY_SET& aPolySet )
+{
+    // a SHAPE_LINE_CHAIN stores a point and an arc index for each vertex
+    size_t bytes = aPolySet.TotalVertices() * ( sizeof( VECTOR2I ) + sizeof( ssize_t ) );
+
+    for( unsigned int ii = 0; ii < aPolySet.TriangulatedPolyCount(); ii++ )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = aPolySet.TriangulatedPolygon( ii );
+
+        bytes += tri->GetVertexCount() * sizeof( VECTOR2I );
+        bytes += tri->GetTriangleCount() * sizeof( SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI );
+    }
+
+    return bytes / std::max( aPolySet.GetPolygonsShareCount(), 1L );
+}
+
+
+/**
+ * Estimate the memory used by a board item, including the heavy data it owns
+ * (zone fills, polygons, footprint children)
+ */
+static size_t itemMemoryUsage( const EDA_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+        size_t        bytes = sizeof( MODULE ) + 2 * sizeof( TEXTE_MODULE );
+
+        for( const D_PAD* pad : module->Pads() )
+            bytes += itemMemoryUsage( pad );
+
+        for( const BOARD_ITEM* item : module->GraphicalItems() )
+            bytes += itemMemoryUsage( item );
+
+        for( const MODULE_ZONE_CONTAINER* zone : module->Zones() )
+            bytes += itemMemoryUsage( zone );
+
+        return bytes;
+    }
+
+    case PCB_ZONE_AREA_T:
+    case PCB_MODULE_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+
+        return sizeof( MODULE_ZONE_CONTAINER )
+               + polySetMemoryUsage( *zone->Outline() )
+               + polySetMemoryUsage( zone->GetFilledPolysList() )
+               + polySetMemoryUsage( zone->RawPolysList() )
+               + zone->FillSegments().size() * sizeof( SEG );
+    }
+
+    case PCB_LINE_T:
+        return sizeof( DRAWSEGMENT )
+               + polySetMemoryUsage( static_cast<const DRAWSEGMENT*>( aItem )->GetPolyShape() );
+
+    case PCB_MODULE_EDGE_T:
+        return sizeof( EDGE_MODULE )
+               + polySetMemoryUsage( static_cast<const DRAWSEGMENT*>( aItem )->GetPolyShape() );
+
+    case PCB_PAD_T:         return sizeof( D_PAD );
+    case PCB_TEXT_T:        return sizeof( TEXTE_PCB );
+    case PCB_MODULE_TEXT_T: return sizeof( TEXTE_MODULE );
+    case PCB_TRACE_T:       return sizeof( TRACK );
+    case PCB_ARC_T:         return sizeof( ARC );
+    case PCB_VIA_T:         return sizeof( VIA );
+    case PCB_DIMENSION_T:   return sizeof( DIMENSION );
+    case PCB_TARGET_T:      return sizeof( PCB_TARGET );
+    default:                return sizeof( BOARD_ITEM );
+    }
+}
+
+
+size_t PCB_SCREEN::GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const
+{
+    size_t bytes = 0;
+
+    // Only count the items owned by the command (see ClearListAndDeleteItems()), the
+    // other ones are still in the board.  This is called again for old commands, whose
+    // board items may be gone: only the items owned by the command are read.
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+    {
+        ITEM_PICKER picker = aCommand.GetItemWrapper( ii );
+
+        bytes += sizeof( ITEM_PICKER );
+
+        if( picker.GetLink() )
+            bytes += itemMemoryUsage( picker.GetLink() );
+
+        if( picker.GetItem() && ( ( picker.GetFlags() & UR_TRANSIENT )
+                                  || picker.GetStatus() == UR_DELETED ) )
+            bytes += itemMemoryUsage( picker.GetItem() );
+    }
+
+    return bytes;
+}
+
+
 void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount )
 {
     if( aItemCount == 0 )
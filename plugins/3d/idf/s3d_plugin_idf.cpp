@@ -72,21 +72,6 @@ static bool addSegment( VRML_LAYER& model, IDF_SEGMENT* seg, int icont, int iseg
 static SCENEGRAPH* vrmlToSG( VRML_LAYER& vpcb, int idxColor, SGNODE* aParent, double top, double bottom );
 
 
-class LOCALESWITCH
-{
-public:
-    LOCALESWITCH()
-    {
-        setlocale( LC_NUMERIC, "C" );
-    }
-
-    ~LOCALESWITCH()
-    {
-        setlocale( LC_NUMERIC, "" );
-    }
-};
-
-
 static SGNODE* getColor( IFSG_SHAPE& shape, int colorIdx )
 {
     IFSG_APPEARANCE material( shape );
@@ -605,7 +590,6 @@ static SCENEGRAPH* addOutline( IDF3_COMP_OUTLINE* outline, int idxColor, SGNODE*
 
 static SCENEGRAPH* loadIDFOutline( const wxString& aFileName )
 {
-    LOCALESWITCH switcher;
     IDF3_BOARD brd( IDF3::CAD_ELEC );
     IDF3_COMP_OUTLINE* outline = NULL;
 
@@ -636,7 +620,6 @@ static SCENEGRAPH* loadIDFOutline( const wxString& aFileName )
 
 static SCENEGRAPH* loadIDFBoard( const wxString& aFileName )
 {
-    LOCALESWITCH switcher;
     IDF3_BOARD brd( IDF3::CAD_ELEC );
 
     // note: if the IDF model is defective no outline substitutes shall be made
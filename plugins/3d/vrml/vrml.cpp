@@ -38,7 +38,6 @@
 #include "vrml2_base.h"
 #include "wrlproc.h"
 #include "x3d.h"
-#include <clocale>
 #include <wx/filename.h>
 #include <wx/log.h>
 
@@ -156,25 +155,6 @@ bool CanRender( void )
 }
 
 
-class LOCALESWITCH
-{
-    // Store the user locale name, to restore this locale later, in dtor
-    std::string m_locale;
-
-public:
-    LOCALESWITCH()
-    {
-        m_locale = setlocale( LC_NUMERIC, 0 );
-        setlocale( LC_NUMERIC, "C" );
-    }
-
-    ~LOCALESWITCH()
-    {
-        setlocale( LC_NUMERIC, m_locale.c_str() );
-    }
-};
-
-
 SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
 {
     FILE_LINE_READER* modelFile = NULL;
@@ -285,8 +265,8 @@ SCENEGRAPH* Load( char const* aFileName )
     if( !wxFileName::FileExists( fname ) )
         return NULL;
 
-    LOCALESWITCH switcher;
-
+    // The numbers are parsed in the C locale by the parsers themselves: the numeric locale
+    // is process wide and models are loaded by several threads at once.
     SCENEGRAPH* scene = NULL;
     wxString ext = wxFileName( fname ).GetExt();
 
@@ -22,6 +22,7 @@
  */
 
 #include <iostream>
+#include <locale>
 #include <sstream>
 #include <wx/filename.h>
 #include <wx/string.h>
@@ -827,6 +828,7 @@ bool WRLPROC::ReadSFFloat( float& aSFFloat )
     }
 
     std::istringstream istr;
+    istr.imbue( std::locale::classic() );
     istr.str( tmp );
     istr >> aSFFloat;
 
@@ -897,6 +899,7 @@ bool WRLPROC::ReadSFInt( int& aSFInt32 )
     }
 
     std::istringstream istr;
+    istr.imbue( std::locale::classic() );
     istr.str( tmp );
     istr >> aSFInt32;
 
@@ -964,6 +967,7 @@ bool WRLPROC::ReadSFRotation( WRLROTATION& aSFRotation )
         }
 
         std::istringstream istr;
+        istr.imbue( std::locale::classic() );
         istr.str( tmp );
         istr >> trot[i];
 
@@ -1037,6 +1041,7 @@ bool WRLPROC::ReadSFVec2f( WRLVEC2F& aSFVec2f )
         }
 
         std::istringstream istr;
+        istr.imbue( std::locale::classic() );
         istr.str( tmp );
         istr >> tcol[i];
 
@@ -1116,6 +1121,7 @@ bool WRLPROC::ReadSFVec3f( WRLVEC3F& aSFVec3f )
             Pop();
 
         std::istringstream istr;
+        istr.imbue( std::locale::classic() );
         istr.str( tmp );
         istr >> tcol[i];
 
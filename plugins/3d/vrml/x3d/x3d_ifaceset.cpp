@@ -127,7 +127,7 @@ void X3DIFACESET::readFields( wxXmlNode* aNode )
             while( indices.HasMoreTokens() )
             {
                 long index = 0;
-                indices.GetNextToken().ToLong( &index );
+                indices.GetNextToken().ToCLong( &index );
                 coordIndex.push_back( (int) index );
             }
         }
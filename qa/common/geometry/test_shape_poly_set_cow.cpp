@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include "fixtures_geometry.h"
+
+/**
+ * Fixture for the copy-on-write test suite. It contains an instance of the common data.
+ */
+struct CopyOnWriteFixture
+{
+    // Structure to store the common data.
+    struct KI_TEST::CommonTestData common;
+};
+
+/**
+ * Declares the CopyOnWriteFixture as the boost test suite fixture.
+ */
+BOOST_FIXTURE_TEST_SUITE( PolygonCopyOnWrite, CopyOnWriteFixture )
+
+/**
+ * Checks that a copy shares the polygons of the original as long as it is only read.
+ */
+BOOST_AUTO_TEST_CASE( CopyShares )
+{
+    SHAPE_POLY_SET copy( common.holeyPolySet );
+
+    BOOST_CHECK_EQUAL( &copy.CPolygon( 0 ), &common.holeyPolySet.CPolygon( 0 ) );
+
+    // Read only accesses must not detach the copy
+    for( auto iterator = copy.CIterateWithHoles(); iterator; iterator++ )
+        ;
+
+    for( auto iterator = copy.Iterate(); iterator; iterator++ )
+        ;
+
+    copy.SquaredDistance( VECTOR2I( 0, 0 ) );
+
+    // The zone fill threads smooth shared zone outlines concurrently
+    copy.Chamfer( 10 );
+    copy.Fillet( 10, 1 );
+
+    BOOST_CHECK_EQUAL( &copy.CPolygon( 0 ), &common.holeyPolySet.CPolygon( 0 ) );
+
+    SHAPE_POLY_SET assigned;
+    assigned = common.holeyPolySet;
+
+    BOOST_CHECK_EQUAL( &assigned.CPolygon( 0 ), &common.holeyPolySet.CPolygon( 0 ) );
+}
+
+/**
+ * Checks that modifying a copy leaves the original unchanged, and vice versa.
+ */
+BOOST_AUTO_TEST_CASE( ModificationDetaches )
+{
+    SHAPE_POLY_SET copy( common.holeyPolySet );
+    VECTOR2I       origin = common.holeyPolySet.CVertex( 0 );
+
+    copy.Move( VECTOR2I( 10, 10 ) );
+
+    BOOST_CHECK( &copy.CPolygon( 0 ) != &common.holeyPolySet.CPolygon( 0 ) );
+    BOOST_CHECK_EQUAL( common.holeyPolySet.CVertex( 0 ), origin );
+    BOOST_CHECK_EQUAL( copy.CVertex( 0 ), origin + VECTOR2I( 10, 10 ) );
+
+    SHAPE_POLY_SET other( common.holeyPolySet );
+    common.holeyPolySet.SetVertex( 0, VECTOR2I( -1, -1 ) );
+
+    BOOST_CHECK_EQUAL( other.CVertex( 0 ), origin );
+
+    SHAPE_POLY_SET fractured( other );
+    fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( fractured.HoleCount( 0 ), 0 );
+    BOOST_CHECK_EQUAL( other.HoleCount( 0 ), 2 );
+
+    SHAPE_POLY_SET cleared( other );
+    cleared.RemoveAllContours();
+
+    BOOST_CHECK_EQUAL( cleared.OutlineCount(), 0 );
+    BOOST_CHECK_EQUAL( other.OutlineCount(), 1 );
+}
+
+/**
+ * Checks that appending a set to itself works on the shared polygons.
+ */
+BOOST_AUTO_TEST_CASE( SelfAppend )
+{
+    SHAPE_POLY_SET copy( common.holeyPolySet );
+
+    copy.Append( copy );
+
+    BOOST_CHECK_EQUAL( copy.OutlineCount(), 2 );
+    BOOST_CHECK_EQUAL( common.holeyPolySet.OutlineCount(), 1 );
+}
+
+/**
+ * Checks that the triangulation is shared by copies and rebuilt only for the modified one.
+ */
+BOOST_AUTO_TEST_CASE( TriangulationSharing )
+{
+    common.holeyPolySet.CacheTriangulation();
+
+    SHAPE_POLY_SET copy( common.holeyPolySet );
+
+    BOOST_CHECK( copy.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( copy.TriangulatedPolygon( 0 ),
+                       common.holeyPolySet.TriangulatedPolygon( 0 ) );
+
+    copy.Move( VECTOR2I( 10, 10 ) );
+
+    BOOST_CHECK( !copy.IsTriangulationUpToDate() );
+    BOOST_CHECK( common.holeyPolySet.IsTriangulationUpToDate() );
+
+    SHAPE_POLY_SET deepCopy( common.holeyPolySet, true );
+
+    BOOST_CHECK( &deepCopy.CPolygon( 0 ) != &common.holeyPolySet.CPolygon( 0 ) );
+    BOOST_CHECK( deepCopy.TriangulatedPolygon( 0 )
+                 != common.holeyPolySet.TriangulatedPolygon( 0 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
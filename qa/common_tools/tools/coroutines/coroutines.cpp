@@ -31,6 +31,7 @@
 
 #include <wx/cmdline.h>
 
+#include <chrono>
 #include <cstdio>
 #include <string>
 
@@ -137,4 +138,59 @@ static bool registered = UTILITY_REGISTRY::Register( {
         "coroutine",
         "Test a simple coroutine",
         coroutine_main_func,
-} );
\ No newline at end of file
+} );
+
+/**
+ * Run many short coroutines, as the TOOL_MANAGER does for each tool invocation, and
+ * report the time taken and the use of the pooled stacks.
+ */
+static int coroutine_bench_func( int argc, char** argv )
+{
+    long count = 100000;
+
+    if( argc > 1 )
+        wxString( argv[1] ).ToLong( &count );
+
+    std::function<int( int )> countTo = []( int n )
+    {
+        return n;
+    };
+
+    const COROUTINE_STACK_POOL& pool = COROUTINE_STACK_POOL::Get();
+
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+
+    for( long i = 0; i < count; ++i )
+    {
+        MyCoroutine cofunc( countTo );
+        cofunc.Call( (int) i );
+
+        while( cofunc.Running() )
+            cofunc.Resume();
+
+        sum += cofunc.ReturnValue();
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start );
+
+    printf( "Coroutine benchmark\n" );
+    printf( "  Coroutines:         %ld (checksum %ld)\n", count, sum );
+    printf( "  Total time:         %lld us\n", (long long) duration.count() );
+    printf( "  Time per coroutine: %.3f us\n",
+            count ? (double) duration.count() / count : 0.0 );
+    printf( "  Stacks mapped:      %zu\n", pool.GetMappedCount() );
+    printf( "  Stacks reused:      %zu\n", pool.GetReusedCount() );
+    printf( "  Stacks in pool:     %zu\n", pool.GetStackCount() );
+    printf( "  Stack high water:   %zu bytes\n", pool.GetHighWaterMark() );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registeredBench = UTILITY_REGISTRY::Register( {
+        "coroutine_bench",
+        "Benchmark the creation of coroutines and report the stack pool use",
+        coroutine_bench_func,
+} );
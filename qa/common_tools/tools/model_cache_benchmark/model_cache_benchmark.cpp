@@ -0,0 +1,199 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <plugins/3dapi/ifsg_api.h>
+
+#include <qa_utils/utility_registry.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+struct MODEL_FILES
+{
+    wxString sceneCache;    ///< the .3dc scene graph cache file
+    wxString modelCache;    ///< the equivalent .3dm model cache file
+};
+
+
+/**
+ * Count the triangles of a model, used both as a sanity check that the two
+ * loaders return the same data and to keep the compiler from removing the loads
+ */
+static unsigned countTriangles( const S3DMODEL* aModel )
+{
+    unsigned count = 0;
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize; ++i )
+        count += aModel->m_Meshes[i].m_FaceIdxSize / 3;
+
+    return count;
+}
+
+
+/**
+ * Load the render data through the scene graph, as done for a model cache miss
+ */
+static unsigned loadFromSceneCache( const MODEL_FILES& aFiles )
+{
+    SGNODE* node = S3D::ReadCache( aFiles.sceneCache.ToUTF8(), NULL, NULL );
+
+    if( !node )
+        return 0;
+
+    S3DMODEL* model = S3D::GetModel( (SCENEGRAPH*) node );
+    unsigned  count = model ? countTriangles( model ) : 0;
+
+    S3D::Destroy3DModel( &model );
+    S3D::DestroyNode( node );
+
+    return count;
+}
+
+
+static unsigned loadFromModelCache( const MODEL_FILES& aFiles )
+{
+    S3DMODEL* model = S3D::ReadModelCache( aFiles.modelCache.ToUTF8(), NULL, NULL );
+    unsigned  count = model ? countTriangles( model ) : 0;
+
+    S3D::Destroy3DModel( &model );
+
+    return count;
+}
+
+
+static std::chrono::milliseconds bench( const std::vector<MODEL_FILES>& aModels, long aReps,
+        unsigned ( *aLoader )( const MODEL_FILES& ), unsigned& aTriangles )
+{
+    aTriangles = 0;
+
+    TIME_PT start = CLOCK::now();
+
+    for( long i = 0; i < aReps; ++i )
+    {
+        for( const MODEL_FILES& files : aModels )
+            aTriangles += aLoader( files );
+    }
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>( CLOCK::now() - start );
+}
+
+
+int model_cache_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <CACHE_DIR> [REPS]\n\n";
+        os << "Compares loading the 3D models of the given 3D cache directory (for instance\n";
+        os << "~/.cache/kicad/3d) from the scene graph cache files (.3dc) and from the\n";
+        os << "model cache files (.3dm).\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString cacheDir = wxString::FromUTF8( argv[1] );
+    long     reps = 1;
+
+    if( argc > 2 )
+        wxString( argv[2] ).ToLong( &reps );
+
+    wxArrayString sceneFiles;
+    wxDir::GetAllFiles( cacheDir, &sceneFiles, "*.3dc", wxDIR_FILES );
+
+    wxFileName tempDir( wxFileName::GetTempDir(), "" );
+    tempDir.AppendDir( "kicad_model_cache_benchmark" );
+    tempDir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    // Write the model cache files outside the user cache, from the existing scene graphs
+    std::vector<MODEL_FILES> models;
+
+    for( const wxString& sceneFile : sceneFiles )
+    {
+        std::string pluginInfo;
+        SGNODE*     node = S3D::ReadCache( sceneFile.ToUTF8(), NULL, NULL, &pluginInfo );
+
+        if( !node )
+            continue;
+
+        MODEL_FILES files;
+        files.sceneCache = sceneFile;
+        files.modelCache = wxFileName( tempDir.GetPath(), wxFileName( sceneFile ).GetName(),
+                                       "3dm" ).GetFullPath();
+
+        S3DMODEL* model = S3D::GetModel( (SCENEGRAPH*) node );
+
+        if( model && S3D::WriteModelCache( files.modelCache.ToUTF8(), model,
+                                           pluginInfo.c_str() ) )
+            models.push_back( files );
+
+        S3D::Destroy3DModel( &model );
+        S3D::DestroyNode( node );
+    }
+
+    os << "3D model cache benchmark" << std::endl;
+    os << "  Cache directory: " << cacheDir << std::endl;
+    os << "  Models:          " << models.size() << std::endl;
+    os << "  Repetitions:     " << reps << std::endl;
+    os << std::endl;
+
+    unsigned sceneTriangles = 0;
+    unsigned modelTriangles = 0;
+
+    std::chrono::milliseconds sceneDur = bench( models, reps, loadFromSceneCache, sceneTriangles );
+    std::chrono::milliseconds modelDur = bench( models, reps, loadFromModelCache, modelTriangles );
+
+    os << wxString::Format( "%-30s %u triangles in %u ms", "scene graph cache (.3dc)",
+                            sceneTriangles, (unsigned) sceneDur.count() ) << std::endl;
+    os << wxString::Format( "%-30s %u triangles in %u ms", "model cache (.3dm)",
+                            modelTriangles, (unsigned) modelDur.count() ) << std::endl;
+
+    for( const MODEL_FILES& files : models )
+        wxRemoveFile( files.modelCache );
+
+    wxFileName::Rmdir( tempDir.GetPath() );
+
+    if( sceneTriangles != modelTriangles )
+    {
+        os << "Triangle counts differ between the two caches" << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "model_cache_benchmark",
+        "Benchmark loading 3D models from the scene graph and model cache files",
+        model_cache_benchmark_func,
+} );
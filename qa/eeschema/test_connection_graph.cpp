@@ -0,0 +1,515 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_connection_graph.cpp
+ * Checks that the incremental update of the connection graph gives the same nets as a full
+ * recalculation, after the kind of edits done in the schematic editor.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <functional>
+#include <set>
+
+#include "eeschema_test_utils.h"
+
+#include <class_libentry.h>
+#include <connection_graph.h>
+#include <kiway.h>
+#include <pgm_base.h>
+#include <sch_component.h>
+#include <sch_connection.h>
+#include <sch_io_mgr.h>
+#include <sch_line.h>
+#include <sch_pin.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_text.h>
+#include <schematic.h>
+#include <wildcards_and_files_ext.h>
+
+
+/// The connectivity of one item on one sheet
+struct NET_INFO
+{
+    wxString        m_name;
+    int             m_code = 0;         ///< net code, or minus the bus code for buses
+    const SCH_ITEM* m_driver = nullptr; ///< driver of the subgraph, if in the net map
+};
+
+/// The connectivity of all the items, by sheet path and item
+typedef std::map<std::pair<wxString, const SCH_ITEM*>, NET_INFO> NET_SNAPSHOT;
+
+
+struct CONNECTION_GRAPH_FIXTURE
+{
+    CONNECTION_GRAPH_FIXTURE() : m_kiway( &Pgm(), KFCTL_STANDALONE )
+    {
+    }
+
+    /**
+     * Loads one of the schematics of the netlist test data and calculates its connectivity.
+     *
+     * The symbol instances of the root sheet are not applied, the references come from the
+     * symbol fields.  This is the same for both calculations compared here.
+     */
+    void loadSchematic( const wxString& aName )
+    {
+        wxFileName fn = KI_TEST::GetEeschemaTestDataDir();
+        fn.AppendDir( "netlists" );
+        fn.AppendDir( aName );
+        fn.SetName( aName );
+        fn.SetExt( ProjectFileExtension );
+
+        m_kiway.Prj().SetProjectFullName( fn.GetFullPath() );
+
+        fn.SetExt( KiCadSchematicFileExtension );
+
+        m_removed.clear();
+        m_schematic.Reset();
+
+        SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_KICAD ) );
+
+        m_schematic.SetRoot( pi->Load( fn.GetFullPath(), &m_kiway, &m_schematic ) );
+        m_schematic.CurrentSheet().push_back( &m_schematic.Root() );
+
+        SCH_SCREENS screens( m_schematic.Root() );
+
+        for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+            screen->UpdateLocalLibSymbolLinks();
+
+        SCH_SHEET_LIST sheets = m_schematic.GetSheets();
+
+        for( SCH_SHEET_PATH& sheet : sheets )
+            sheet.UpdateAllScreenReferences();
+
+        m_schematic.ConnectionGraph()->Recalculate( sheets, true );
+    }
+
+    void recalculate( bool aUnconditional )
+    {
+        m_schematic.ConnectionGraph()->Recalculate( m_schematic.GetSheets(), aUnconditional );
+    }
+
+    /**
+     * @return the items of all the screens matching aFilter, screen after screen in the
+     *         order of the sheets, with their screen
+     */
+    std::vector<std::pair<SCH_SCREEN*, SCH_ITEM*>> findItems(
+            const std::function<bool( SCH_ITEM* )>& aFilter )
+    {
+        std::vector<std::pair<SCH_SCREEN*, SCH_ITEM*>> found;
+        std::set<SCH_SCREEN*>                          screens;
+
+        for( const SCH_SHEET_PATH& sheet : m_schematic.GetSheets() )
+        {
+            SCH_SCREEN* screen = sheet.LastScreen();
+
+            if( !screens.insert( screen ).second )
+                continue;
+
+            for( SCH_ITEM* item : screen->Items() )
+            {
+                if( aFilter( item ) )
+                    found.emplace_back( screen, item );
+            }
+        }
+
+        return found;
+    }
+
+    static bool isWire( SCH_ITEM* aItem )
+    {
+        return aItem->Type() == SCH_LINE_T && aItem->GetLayer() == LAYER_WIRE;
+    }
+
+    static bool isPowerSymbol( SCH_ITEM* aItem )
+    {
+        if( aItem->Type() != SCH_COMPONENT_T )
+            return false;
+
+        std::unique_ptr<LIB_PART>& part = static_cast<SCH_COMPONENT*>( aItem )->GetPartRef();
+
+        return part && part->IsPower();
+    }
+
+    static bool isRegularSymbol( SCH_ITEM* aItem )
+    {
+        return aItem->Type() == SCH_COMPONENT_T && !isPowerSymbol( aItem );
+    }
+
+    void move( SCH_SCREEN* aScreen, SCH_ITEM* aItem, const wxPoint& aOffset )
+    {
+        aItem->Move( aOffset );
+        aItem->SetConnectivityDirty();
+        aScreen->Update( aItem );
+    }
+
+    /// Removes an item from its screen, keeping it alive as the undo list does
+    void remove( SCH_SCREEN* aScreen, SCH_ITEM* aItem )
+    {
+        aScreen->Remove( aItem );
+        m_removed.emplace_back( aItem );
+    }
+
+    // The edits, as done by the schematic editor.  They return false when the schematic
+    // has nothing to apply them to.
+
+    bool moveWire()
+    {
+        auto wires = findItems( isWire );
+
+        if( wires.empty() )
+            return false;
+
+        move( wires.front().first, wires.front().second,
+              wxPoint( Mils2iu( 100 ), Mils2iu( 50 ) ) );
+        return true;
+    }
+
+    bool deleteWire()
+    {
+        auto wires = findItems( isWire );
+
+        if( wires.size() < 2 )
+            return false;
+
+        remove( wires[1].first, wires[1].second );
+        return true;
+    }
+
+    /// Joins the ends of the first and last wires of a screen, merging their nets
+    bool addWire()
+    {
+        auto wires = findItems( isWire );
+
+        if( wires.size() < 2 )
+            return false;
+
+        SCH_SCREEN* screen = wires.front().first;
+        SCH_LINE*   first = static_cast<SCH_LINE*>( wires.front().second );
+        SCH_LINE*   last = first;
+
+        for( const auto& wire : wires )
+        {
+            if( wire.first == screen )
+                last = static_cast<SCH_LINE*>( wire.second );
+        }
+
+        SCH_LINE* line = new SCH_LINE( first->GetStartPoint(), LAYER_WIRE );
+        line->SetEndPoint( last->GetEndPoint() );
+        screen->Append( line );
+        return true;
+    }
+
+    /// Gives a local label a new name, splitting it from the other labels of its net
+    bool renameLabel()
+    {
+        auto labels = findItems( []( SCH_ITEM* aItem )
+                                 {
+                                     return aItem->Type() == SCH_LABEL_T;
+                                 } );
+
+        if( labels.empty() )
+            return false;
+
+        SCH_TEXT* label = static_cast<SCH_TEXT*>( labels.front().second );
+
+        label->SetText( label->GetText() + wxT( "_RENAMED" ) );
+        label->SetConnectivityDirty();
+        labels.front().first->Update( label );
+        return true;
+    }
+
+    /// Deletes a hierarchical label, breaking the link with its sheet pin
+    bool deleteLabel()
+    {
+        auto labels = findItems( []( SCH_ITEM* aItem )
+                                 {
+                                     return aItem->Type() == SCH_HIER_LABEL_T;
+                                 } );
+
+        if( labels.empty() )
+            return false;
+
+        remove( labels.front().first, labels.front().second );
+        return true;
+    }
+
+    /// Adds a global label named as an existing one on the last wire of the schematic
+    bool addGlobalLabel()
+    {
+        auto wires = findItems( isWire );
+        auto globals = findItems( []( SCH_ITEM* aItem )
+                                  {
+                                      return aItem->Type() == SCH_GLOBAL_LABEL_T;
+                                  } );
+
+        if( wires.empty() )
+            return false;
+
+        wxString name = wxT( "NEW_GLOBAL" );
+
+        if( !globals.empty() )
+            name = static_cast<SCH_TEXT*>( globals.front().second )->GetText();
+
+        SCH_SCREEN*     screen = wires.back().first;
+        SCH_LINE*       wire = static_cast<SCH_LINE*>( wires.back().second );
+        SCH_GLOBALLABEL* label = new SCH_GLOBALLABEL( wire->GetEndPoint(), name );
+
+        screen->Append( label );
+        return true;
+    }
+
+    bool moveSymbol()
+    {
+        auto symbols = findItems( isRegularSymbol );
+
+        if( symbols.empty() )
+            return false;
+
+        move( symbols.front().first, symbols.front().second, wxPoint( Mils2iu( 200 ), 0 ) );
+        return true;
+    }
+
+    bool deleteSymbol()
+    {
+        auto symbols = findItems( isRegularSymbol );
+
+        if( symbols.size() < 2 )
+            return false;
+
+        remove( symbols[1].first, symbols[1].second );
+        return true;
+    }
+
+    /// Duplicates a power symbol and places its pin on the start of the last wire
+    bool addPowerSymbol()
+    {
+        auto wires = findItems( isWire );
+        auto powers = findItems( isPowerSymbol );
+
+        if( wires.empty() || powers.empty() )
+            return false;
+
+        SCH_SCREEN*    screen = wires.back().first;
+        SCH_LINE*      wire = static_cast<SCH_LINE*>( wires.back().second );
+        SCH_COMPONENT* symbol = static_cast<SCH_COMPONENT*>( powers.front().second->Duplicate() );
+
+        if( symbol->GetSchPins().empty() )
+        {
+            delete symbol;
+            return false;
+        }
+
+        symbol->Move( wire->GetStartPoint() - symbol->GetSchPins().front()->GetPosition() );
+        symbol->ClearAnnotation( nullptr );
+        screen->Append( symbol );
+        return true;
+    }
+
+    /// @return the net names, net codes and subgraph drivers of all the connectable items
+    NET_SNAPSHOT snapshot()
+    {
+        NET_SNAPSHOT nets;
+
+        for( const SCH_SHEET_PATH& sheet : m_schematic.GetSheets() )
+        {
+            const wxString path = sheet.Path().AsString();
+
+            for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+            {
+                if( !item->IsConnectable() )
+                    continue;
+
+                std::vector<SCH_ITEM*> connectables;
+
+                if( item->Type() == SCH_COMPONENT_T )
+                {
+                    for( SCH_PIN* pin : static_cast<SCH_COMPONENT*>( item )->GetSchPins( &sheet ) )
+                        connectables.push_back( pin );
+                }
+                else if( item->Type() == SCH_SHEET_T )
+                {
+                    for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+                        connectables.push_back( pin );
+                }
+                else
+                {
+                    connectables.push_back( item );
+                }
+
+                for( SCH_ITEM* connectable : connectables )
+                {
+                    NET_INFO&       info = nets[std::make_pair( path, connectable )];
+                    SCH_CONNECTION* connection = connectable->Connection( sheet );
+
+                    if( connection )
+                    {
+                        info.m_name = connection->Name();
+                        info.m_code = connection->IsBus() ? -connection->BusCode()
+                                                          : connection->NetCode();
+                    }
+                }
+            }
+        }
+
+        // The net map is what the netlisters use
+        for( const auto& net : m_schematic.ConnectionGraph()->GetNetMap() )
+        {
+            for( const CONNECTION_SUBGRAPH* subgraph : net.second )
+            {
+                for( const SCH_ITEM* item : subgraph->m_items )
+                {
+                    NET_INFO& info = nets[std::make_pair( subgraph->m_sheet.Path().AsString(),
+                                                          item )];
+
+                    info.m_name = net.first.first;
+                    info.m_code = net.first.second;
+                    info.m_driver = subgraph->m_driver;
+                }
+            }
+        }
+
+        return nets;
+    }
+
+    /**
+     * Checks that two snapshots give the same nets.  The net codes of an incremental update
+     * are not renumbered, so the codes must only group the same items.
+     */
+    void checkSameNets( const NET_SNAPSHOT& aIncremental, const NET_SNAPSHOT& aFull )
+    {
+        BOOST_CHECK_EQUAL( aIncremental.size(), aFull.size() );
+
+        std::map<int, int> incrementalToFull;
+        std::map<int, int> fullToIncremental;
+
+        for( const auto& full : aFull )
+        {
+            BOOST_TEST_CONTEXT( full.first.second->GetClass() << " on sheet " << full.first.first
+                                << ", net " << full.second.m_name )
+            {
+                auto it = aIncremental.find( full.first );
+
+                BOOST_CHECK( it != aIncremental.end() );
+
+                if( it == aIncremental.end() )
+                    continue;
+
+                const NET_INFO& incremental = it->second;
+
+                BOOST_CHECK_EQUAL( incremental.m_name, full.second.m_name );
+                BOOST_CHECK( incremental.m_driver == full.second.m_driver );
+
+                // Both codes must stand for the same net everywhere
+                int fullCode = incrementalToFull.emplace( incremental.m_code,
+                                                          full.second.m_code ).first->second;
+                int incrementalCode = fullToIncremental.emplace( full.second.m_code,
+                                                                 incremental.m_code ).first->second;
+
+                BOOST_CHECK_EQUAL( fullCode, full.second.m_code );
+                BOOST_CHECK_EQUAL( incrementalCode, incremental.m_code );
+            }
+        }
+    }
+
+    /**
+     * For each edit, reloads the schematic and replays the previous edits with incremental
+     * updates, as the editor does.  After the edit, compares the incremental update with
+     * a full recalculation.
+     */
+    void checkEdits( const wxString& aName )
+    {
+        typedef bool ( CONNECTION_GRAPH_FIXTURE::*EDIT )();
+
+        const std::vector<std::pair<std::string, EDIT>> edits = {
+            { "move wire",          &CONNECTION_GRAPH_FIXTURE::moveWire },
+            { "delete wire",        &CONNECTION_GRAPH_FIXTURE::deleteWire },
+            { "add wire",           &CONNECTION_GRAPH_FIXTURE::addWire },
+            { "rename label",       &CONNECTION_GRAPH_FIXTURE::renameLabel },
+            { "delete label",       &CONNECTION_GRAPH_FIXTURE::deleteLabel },
+            { "add global label",   &CONNECTION_GRAPH_FIXTURE::addGlobalLabel },
+            { "move symbol",        &CONNECTION_GRAPH_FIXTURE::moveSymbol },
+            { "delete symbol",      &CONNECTION_GRAPH_FIXTURE::deleteSymbol },
+            { "add power symbol",   &CONNECTION_GRAPH_FIXTURE::addPowerSymbol },
+        };
+
+        for( size_t step = 0; step < edits.size(); ++step )
+        {
+            BOOST_TEST_CONTEXT( aName << ", " << edits[step].first )
+            {
+                loadSchematic( aName );
+
+                for( size_t ii = 0; ii < step; ++ii )
+                {
+                    if( ( this->*edits[ii].second )() )
+                        recalculate( false );
+                }
+
+                if( ( this->*edits[step].second )() )
+                {
+                    recalculate( false );
+                    NET_SNAPSHOT incremental = snapshot();
+
+                    recalculate( true );
+                    NET_SNAPSHOT full = snapshot();
+
+                    checkSameNets( incremental, full );
+                }
+            }
+        }
+    }
+
+    KIWAY                                  m_kiway;
+    SCHEMATIC                              m_schematic;
+
+    /// The items removed by the edits
+    std::vector<std::unique_ptr<SCH_ITEM>> m_removed;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ConnectionGraph, CONNECTION_GRAPH_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( IncrementalComplexHierarchy )
+{
+    checkEdits( "complex_hierarchy" );
+}
+
+
+BOOST_AUTO_TEST_CASE( IncrementalGlobalPromotion )
+{
+    checkEdits( "test_global_promotion" );
+    checkEdits( "test_global_promotion_2" );
+}
+
+
+BOOST_AUTO_TEST_CASE( IncrementalVideo )
+{
+    checkEdits( "video" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -81,4 +81,22 @@ BOOST_AUTO_TEST_CASE( Orientation )
 }
 
 
+/**
+ * Check that the oriented copy of the library symbol follows an assignment.
+ */
+BOOST_AUTO_TEST_CASE( OrientedPartAfterAssignment )
+{
+    SCH_COMPONENT other;
+
+    m_symbol.SetLibSymbol( new LIB_PART( "first" ) );
+    other.SetLibSymbol( new LIB_PART( "second" ) );
+
+    BOOST_CHECK_EQUAL( m_symbol.GetOrientedPart()->GetName(), "first" );
+
+    m_symbol = other;
+
+    BOOST_CHECK_EQUAL( m_symbol.GetOrientedPart()->GetName(), "second" );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
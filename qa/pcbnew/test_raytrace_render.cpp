@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_raytrace_render.cpp
+ * Render a board with the raytracer into a memory buffer, without any OpenGL context.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <class_drawsegment.h>
+
+#include <3d_canvas/board_adapter.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+#include <3d_rendering/ctrack_ball.h>
+
+
+struct RAYTRACE_RENDER_FIXTURE
+{
+    RAYTRACE_RENDER_FIXTURE() :
+            m_camera( RANGE_SCALE_3D ),
+            m_renderer( m_adapter, m_camera )
+    {
+        // A 40 x 30 mm board outline
+        const wxPoint corners[] = { { 0, 0 },
+                                    { Millimeter2iu( 40 ), 0 },
+                                    { Millimeter2iu( 40 ), Millimeter2iu( 30 ) },
+                                    { 0, Millimeter2iu( 30 ) } };
+
+        for( int ii = 0; ii < 4; ++ii )
+        {
+            DRAWSEGMENT* segment = new DRAWSEGMENT( &m_board );
+
+            segment->SetLayer( Edge_Cuts );
+            segment->SetStart( corners[ii] );
+            segment->SetEnd( corners[( ii + 1 ) % 4] );
+            m_board.Add( segment );
+        }
+
+        // No 3D model cache and no color settings: draw only the board body, in a color far
+        // from the background gradient
+        m_adapter.SetBoard( &m_board );
+        m_adapter.RenderEngineSet( RENDER_ENGINE::RAYTRACING );
+        m_adapter.SetFlag( FL_SHOW_BOARD_BODY, true );
+        m_adapter.SetFlag( FL_USE_REALISTIC_MODE, true );
+        m_adapter.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, true );
+        m_adapter.m_BoardBodyColor = SFVEC3D( 1.0, 0.0, 0.0 );
+    }
+
+    /// @return the RGBA pixel at x, y of a buffer rendered by RenderToBuffer()
+    const GLubyte* pixel( const std::vector<GLubyte>& aBuffer, unsigned int x, unsigned int y )
+    {
+        return &aBuffer[( y * m_renderer.GetRealBufferSize().x + x ) * 4];
+    }
+
+    BOARD                 m_board;
+    BOARD_ADAPTER         m_adapter;
+    CTRACK_BALL           m_camera;
+    C3D_RENDER_RAYTRACING m_renderer;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( RaytraceRender, RAYTRACE_RENDER_FIXTURE )
+
+
+/**
+ * The default view looks at the board from the top: the board body fills the middle of the
+ * image and the corners show the background.
+ */
+BOOST_AUTO_TEST_CASE( BoardToBuffer )
+{
+    const wxSize size( 320, 240 );
+
+    std::vector<GLubyte> buffer;
+
+    m_camera.SetCurWindowSize( size );
+    m_renderer.RenderToBuffer( size, buffer );
+
+    const SFVEC2UI realSize = m_renderer.GetRealBufferSize();
+
+    BOOST_CHECK_GT( realSize.x, 0 );
+    BOOST_CHECK_GT( realSize.y, 0 );
+    BOOST_CHECK_LE( realSize.x, (unsigned int) size.x );
+    BOOST_CHECK_LE( realSize.y, (unsigned int) size.y );
+    BOOST_REQUIRE_EQUAL( buffer.size(), realSize.x * realSize.y * 4 );
+
+    // The full quality render leaves no pixel transparent
+    for( size_t ii = 3; ii < buffer.size(); ii += 4 )
+        BOOST_REQUIRE_EQUAL( buffer[ii], 255 );
+
+    const GLubyte* center = pixel( buffer, realSize.x / 2, realSize.y / 2 );
+    const GLubyte* corner = pixel( buffer, 0, 0 );
+
+    BOOST_CHECK_GT( center[0], center[2] );
+    BOOST_CHECK_LT( corner[0], corner[2] );
+
+    // A new size resizes the render buffers
+    const wxSize smallSize( 160, 120 );
+
+    m_camera.SetCurWindowSize( smallSize );
+    m_renderer.RenderToBuffer( smallSize, buffer );
+
+    BOOST_CHECK_LT( m_renderer.GetRealBufferSize().x, realSize.x );
+    BOOST_CHECK_EQUAL( buffer.size(),
+                       m_renderer.GetRealBufferSize().x * m_renderer.GetRealBufferSize().y * 4 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
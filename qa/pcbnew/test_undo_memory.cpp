@@ -0,0 +1,136 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <math/util.h>
+#include <pcb_screen.h>
+#include <undo_redo_container.h>
+
+
+struct UNDO_MEMORY_FIXTURE
+{
+    UNDO_MEMORY_FIXTURE() : m_screen( wxSize( 1000, 1000 ) )
+    {
+        // The zone fill is sized so that two full copies exceed the budget
+        m_screen.SetMaxUndoMemory( 1 );
+        m_zone = new ZONE_CONTAINER( &m_board );
+        m_board.Add( m_zone );
+        fillZone( FILL_VERTICES );
+    }
+
+    ///> Replaces the zone fill by a new polygon, as the zone filler does
+    void fillZone( int aVertexCount )
+    {
+        SHAPE_POLY_SET fill;
+        fill.NewOutline();
+
+        for( int ii = 0; ii < aVertexCount; ++ii )
+        {
+            double angle = 2.0 * M_PI * ii / aVertexCount;
+            fill.Append( KiROUND( 1e7 * cos( angle ) ), KiROUND( 1e7 * sin( angle ) ) );
+        }
+
+        m_zone->SetFilledPolysList( fill );
+    }
+
+    ///> Builds the undo command of a zone edit: the command holds a copy of the zone
+    PICKED_ITEMS_LIST* makeZoneEdit()
+    {
+        PICKED_ITEMS_LIST* command = new PICKED_ITEMS_LIST();
+        ITEM_PICKER        picker( m_zone, UR_CHANGED );
+
+        picker.SetLink( m_zone->Clone() );
+        command->PushItem( picker );
+
+        return command;
+    }
+
+    // About 640 kB of vertices
+    static constexpr int FILL_VERTICES = 40000;
+
+    BOARD           m_board;
+    PCB_SCREEN      m_screen;
+    ZONE_CONTAINER* m_zone;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( UndoMemory, UNDO_MEMORY_FIXTURE )
+
+
+/**
+ * Undo copies of a zone share its fill with the zone until it is refilled, so the fill is
+ * counted once for all of them, and unrefilled edits must not evict each other.
+ */
+BOOST_AUTO_TEST_CASE( SharedZoneFill )
+{
+    const size_t fillBytes = FILL_VERTICES * sizeof( VECTOR2I );
+
+    PICKED_ITEMS_LIST* first = makeZoneEdit();
+    BOOST_CHECK_LT( m_screen.GetCommandMemoryUsage( *first ), fillBytes );
+    m_screen.PushCommandToUndoList( first );
+
+    PICKED_ITEMS_LIST* second = makeZoneEdit();
+    BOOST_CHECK_LT( m_screen.GetCommandMemoryUsage( *second ), fillBytes );
+    m_screen.PushCommandToUndoList( second );
+
+    BOOST_CHECK_EQUAL( m_screen.GetUndoCommandCount(), 2 );
+}
+
+
+/**
+ * Once the zone is refilled, the fill held by an undo copy belongs to the copy alone and is
+ * counted in full.
+ */
+BOOST_AUTO_TEST_CASE( RefilledZone )
+{
+    const size_t fillBytes = FILL_VERTICES * sizeof( VECTOR2I );
+
+    PICKED_ITEMS_LIST* edit = makeZoneEdit();
+    fillZone( FILL_VERTICES / 2 );
+
+    BOOST_CHECK_GE( m_screen.GetCommandMemoryUsage( *edit ), fillBytes );
+
+    m_screen.PushCommandToUndoList( edit );
+}
+
+
+/**
+ * Zones are refilled after their edit is pushed.  The fill kept by the pushed command then
+ * becomes its own, and must count in the budget when the next command is pushed.
+ */
+BOOST_AUTO_TEST_CASE( RefilledAfterPush )
+{
+    m_screen.PushCommandToUndoList( makeZoneEdit() );
+    fillZone( FILL_VERTICES );
+
+    m_screen.PushCommandToUndoList( makeZoneEdit() );
+
+    BOOST_CHECK_EQUAL( m_screen.GetUndoCommandCount(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <memory>
+
+#include <class_board.h>
+#include <class_drawsegment.h>
+#include <class_zone.h>
+#include <zone_filler.h>
+#include <zone_settings.h>
+
+
+struct ZONE_FILLER_FIXTURE
+{
+    ZONE_FILLER_FIXTURE()
+    {
+        // A 40 x 40 mm board outline
+        const wxPoint corners[] = { { 0, 0 },
+                                    { Millimeter2iu( 40 ), 0 },
+                                    { Millimeter2iu( 40 ), Millimeter2iu( 40 ) },
+                                    { 0, Millimeter2iu( 40 ) } };
+
+        for( int ii = 0; ii < 4; ++ii )
+        {
+            DRAWSEGMENT* segment = new DRAWSEGMENT( &m_board );
+
+            segment->SetLayer( Edge_Cuts );
+            segment->SetStart( corners[ii] );
+            segment->SetEnd( corners[( ii + 1 ) % 4] );
+            m_board.Add( segment );
+        }
+    }
+
+    ///> Adds a filleted rectangular zone on F_Cu
+    ZONE_CONTAINER* addZone( const wxPoint& aStart, const wxPoint& aEnd, unsigned aPriority )
+    {
+        ZONE_CONTAINER* zone = new ZONE_CONTAINER( &m_board );
+
+        zone->SetLayer( F_Cu );
+        zone->SetPriority( aPriority );
+        zone->SetCornerSmoothingType( ZONE_SETTINGS::SMOOTHING_FILLET );
+        zone->SetCornerRadius( Millimeter2iu( 1 ) );
+
+        zone->Outline()->NewOutline();
+        zone->Outline()->Append( aStart.x, aStart.y );
+        zone->Outline()->Append( aEnd.x, aStart.y );
+        zone->Outline()->Append( aEnd.x, aEnd.y );
+        zone->Outline()->Append( aStart.x, aEnd.y );
+
+        m_board.Add( zone );
+        return zone;
+    }
+
+    BOARD m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFiller, ZONE_FILLER_FIXTURE )
+
+
+/**
+ * The fill threads knock out the same higher priority zone from every other zone at the
+ * same time.  When its outline is shared with an undo copy, they must only read it: the
+ * outline must still be shared once the zones are filled.
+ */
+BOOST_AUTO_TEST_CASE( SharedOutline )
+{
+    const wxPoint center( Millimeter2iu( 20 ), Millimeter2iu( 20 ) );
+
+    ZONE_CONTAINER* island = addZone( center - wxPoint( Millimeter2iu( 5 ), Millimeter2iu( 5 ) ),
+                                      center + wxPoint( Millimeter2iu( 5 ), Millimeter2iu( 5 ) ),
+                                      1 );
+
+    std::unique_ptr<ZONE_CONTAINER> copy( static_cast<ZONE_CONTAINER*>( island->Clone() ) );
+    BOOST_REQUIRE( island->Outline()->SharesPolygonsWith( *copy->Outline() ) );
+
+    std::vector<ZONE_CONTAINER*> zones = { island };
+
+    for( int ii = 0; ii < 8; ++ii )
+    {
+        zones.push_back( addZone( wxPoint( Millimeter2iu( 2 + ii ), Millimeter2iu( 2 ) ),
+                                  wxPoint( Millimeter2iu( 30 + ii ), Millimeter2iu( 38 ) ),
+                                  0 ) );
+    }
+
+    ZONE_FILLER filler( &m_board );
+    BOOST_REQUIRE( filler.Fill( zones ) );
+
+    BOOST_CHECK( island->Outline()->SharesPolygonsWith( *copy->Outline() ) );
+
+    BOOST_CHECK( island->IsFilled() );
+    BOOST_CHECK( island->GetFilledPolysList().Contains( center ) );
+
+    for( size_t ii = 1; ii < zones.size(); ++ii )
+    {
+        BOOST_TEST_CONTEXT( "zone " << ii )
+        {
+            BOOST_CHECK( zones[ii]->IsFilled() );
+            BOOST_CHECK( !zones[ii]->GetFilledPolysList().IsEmpty() );
+            BOOST_CHECK( !zones[ii]->GetFilledPolysList().Contains( center ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -35,6 +35,7 @@
 #include <string>
 #include <iomanip>
 #include <cmath>
+#include <limits>
 #include <vrml_layer.h>
 #include <trigo.h>
 
@@ -47,38 +48,73 @@
 // minimum sides to a circle
 #define MIN_NSIDES 6
 
-static void FormatDoublet( double x, double y, int precision, std::string& strx, std::string& stry )
+// Formats x with 'precision' decimals, as std::fixed does, and trims the trailing zeros.
+// This is called for every vertex written, so the digits are computed directly rather than
+// through a new string stream for each value.
+static void FormatSinglet( double x, int precision, std::string& strx )
 {
-    std::ostringstream ostr;
+    static const double scales[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+    double scaled = precision >= 0 && precision <= 9 ? std::abs( x ) * scales[precision] : -1.0;
 
-    ostr << std::fixed << std::setprecision( precision );
+    // The scaling may be off by an ulp, so values close to halfway between two outputs are
+    // left to the stream for the same rounding as before
+    bool nearHalf = std::abs( scaled - std::floor( scaled ) - 0.5 )
+                    <= ( scaled + 1.0 ) * 4 * std::numeric_limits<double>::epsilon();
 
-    ostr << x;
-    strx = ostr.str();
+    if( !( scaled >= 0.0 && scaled < 1e15 ) || nearHalf )
+    {
+        // out of range of the fast path (huge value, NaN, unusual precision or near a tie)
+        std::ostringstream ostr;
 
-    ostr.str( "" );
-    ostr << y;
-    stry = ostr.str();
+        ostr << std::fixed << std::setprecision( precision );
+        ostr << x;
+        strx = ostr.str();
 
-    while( *strx.rbegin() == '0' )
-        strx.erase( strx.size() - 1 );
+        while( *strx.rbegin() == '0' )
+            strx.erase( strx.size() - 1 );
 
-    while( *stry.rbegin() == '0' )
-        stry.erase( stry.size() - 1 );
-}
+        return;
+    }
 
+    unsigned long long value = (unsigned long long) std::llround( scaled );
+    char               buf[48];
+    char*              end = buf + sizeof( buf );
+    char*              p = end;
 
-static void FormatSinglet( double x, int precision, std::string& strx )
-{
-    std::ostringstream ostr;
+    // fractional digits, least significant first; trailing zeros are dropped
+    bool trailing = true;
 
-    ostr << std::fixed << std::setprecision( precision );
+    for( int i = 0; i < precision; ++i, value /= 10 )
+    {
+        char digit = '0' + value % 10;
 
-    ostr << x;
-    strx = ostr.str();
+        if( trailing && digit == '0' )
+            continue;
 
-    while( *strx.rbegin() == '0' )
-        strx.erase( strx.size() - 1 );
+        trailing = false;
+        *--p = digit;
+    }
+
+    *--p = '.';
+
+    do
+    {
+        *--p = '0' + value % 10;
+        value /= 10;
+    } while( value );
+
+    if( std::signbit( x ) )
+        *--p = '-';
+
+    strx.assign( p, end );
+}
+
+
+static void FormatDoublet( double x, double y, int precision, std::string& strx, std::string& stry )
+{
+    FormatSinglet( x, precision, strx );
+    FormatSinglet( y, precision, stry );
 }
 
 
@@ -366,6 +402,42 @@ bool VRML_LAYER::AddVertex( int aContourID, double aXpos, double aYpos )
 }
 
 
+// adds a copy of the contours of another layer; the vertex indices of the
+// copied contours are shifted after the existing vertices
+bool VRML_LAYER::AppendContours( const VRML_LAYER& aSource )
+{
+    if( fix )
+    {
+        error = "AppendContours(): no more vertices may be added (Tesselate was previously executed)";
+        return false;
+    }
+
+    int base = idx;
+
+    for( const VERTEX_3D* source : aSource.vertices )
+    {
+        VERTEX_3D* vertex = new VERTEX_3D( *source );
+        vertex->i   = idx++;
+        vertex->o   = -1;
+        vertices.push_back( vertex );
+    }
+
+    for( size_t i = 0; i < aSource.contours.size(); ++i )
+    {
+        std::list<int>* contour = new std::list<int>;
+
+        for( int vertexIdx : *aSource.contours[i] )
+            contour->push_back( vertexIdx + base );
+
+        contours.push_back( contour );
+        areas.push_back( aSource.areas[i] );
+        pth.push_back( aSource.pth[i] );
+    }
+
+    return true;
+}
+
+
 // ensure the winding of a contour with respect to the normal (0, 0, 1);
 // set 'hole' to true to ensure a hole (clockwise winding)
 bool VRML_LAYER::EnsureWinding( int aContourID, bool aHoleFlag )
@@ -995,6 +1067,24 @@ bool VRML_LAYER::pushOutline( VRML_LAYER* holes )
 }
 
 
+// appends a vertex to a buffer of formatted vertices, the first one of a
+// line if aNewLine is set; strz is the formatted Z coordinate
+static void appendVertex( std::string& aBuffer, double x, double y, const std::string& strz,
+                          int aPrecision, bool aNewLine, std::string& strx, std::string& stry )
+{
+    FormatDoublet( x, y, aPrecision, strx, stry );
+
+    if( !aBuffer.empty() )
+        aBuffer += aNewLine ? ",\n" : ", ";
+
+    aBuffer += strx;
+    aBuffer += ' ';
+    aBuffer += stry;
+    aBuffer += ' ';
+    aBuffer += strz;
+}
+
+
 // writes out the vertex list for a planar feature
 bool VRML_LAYER::WriteVertices( double aZcoord, std::ostream& aOutFile, int aPrecision )
 {
@@ -1007,34 +1097,24 @@ bool VRML_LAYER::WriteVertices( double aZcoord, std::ostream& aOutFile, int aPre
     if( aPrecision < 4 )
         aPrecision = 4;
 
-    int i, j;
-
-    VERTEX_3D* vp = getVertexByIndex( ordmap[0], pholes );
-
-    if( !vp )
-        return false;
-
-    std::string strx, stry, strz;
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
+    // the vertices are formatted in a buffer written at once, two per line
+    std::string buffer, strx, stry, strz;
+    buffer.reserve( ordmap.size() * 32 );
     FormatSinglet( aZcoord, aPrecision, strz );
 
-    aOutFile << strx << " " << stry << " " << strz;
-
-    for( i = 1, j = ordmap.size(); i < j; ++i )
+    for( size_t i = 0; i < ordmap.size(); ++i )
     {
-        vp = getVertexByIndex( ordmap[i], pholes );
+        VERTEX_3D* vp = getVertexByIndex( ordmap[i], pholes );
 
         if( !vp )
             return false;
 
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-
-        if( i & 1 )
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-        else
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
+        appendVertex( buffer, vp->x + offsetX, vp->y + offsetY, strz, aPrecision,
+                      ( i & 1 ) == 0, strx, stry );
     }
 
+    aOutFile << buffer;
+
     return !aOutFile.fail();
 }
 
@@ -1059,69 +1139,30 @@ bool VRML_LAYER::Write3DVertices( double aTopZ, double aBottomZ,
         return false;
     }
 
-    int i, j;
-
-    VERTEX_3D* vp = getVertexByIndex( ordmap[0], pholes );
-
-    if( !vp )
-        return false;
+    // the top then the bottom vertices are formatted in a buffer written at once,
+    // two per line
+    std::string buffer, strx, stry, strz;
+    size_t      n = 0;
+    buffer.reserve( ordmap.size() * 64 );
 
-    std::string strx, stry, strz;
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-    FormatSinglet( aTopZ, aPrecision, strz );
-
-    aOutFile << strx << " " << stry << " " << strz;
-
-    for( i = 1, j = ordmap.size(); i < j; ++i )
+    for( double z : { aTopZ, aBottomZ } )
     {
-        vp = getVertexByIndex( ordmap[i], pholes );
+        FormatSinglet( z, aPrecision, strz );
 
-        if( !vp )
-            return false;
-
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-
-        if( i & 1 )
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-        else
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
-    }
-
-    // repeat for the bottom layer
-    vp = getVertexByIndex( ordmap[0], pholes );
-    FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
-    FormatSinglet( aBottomZ, aPrecision, strz );
-
-    bool endl;
-
-    if( i & 1 )
-    {
-        aOutFile << ", " << strx << " " << stry << " " << strz;
-        endl = false;
-    }
-    else
-    {
-        aOutFile << ",\n" << strx << " " << stry << " " << strz;
-        endl = true;
-    }
+        for( size_t i = 0; i < ordmap.size(); ++i, ++n )
+        {
+            VERTEX_3D* vp = getVertexByIndex( ordmap[i], pholes );
 
-    for( i = 1, j = ordmap.size(); i < j; ++i )
-    {
-        vp = getVertexByIndex( ordmap[i], pholes );
-        FormatDoublet( vp->x + offsetX, vp->y + offsetY, aPrecision, strx, stry );
+            if( !vp )
+                return false;
 
-        if( endl )
-        {
-            aOutFile << ", " << strx << " " << stry << " " << strz;
-            endl = false;
-        }
-        else
-        {
-            aOutFile << ",\n" << strx << " " << stry << " " << strz;
-            endl = true;
+            appendVertex( buffer, vp->x + offsetX, vp->y + offsetY, strz, aPrecision,
+                          ( n & 1 ) == 0, strx, stry );
         }
     }
 
+    aOutFile << buffer;
+
     return !aOutFile.fail();
 }
 
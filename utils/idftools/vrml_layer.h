@@ -222,6 +222,20 @@ public:
      */
     bool AddVertex( int aContourID, double aXpos, double aYpos );
 
+    /**
+     * Function AppendContours
+     * adds a copy of all the contours of another layer, for instance to give
+     * each layer its own copy of a holes layer.  Tesselate() renumbers the
+     * vertices of the holes layer it is given, so layers sharing the same holes
+     * object cannot be tesselated concurrently nor written after each other's
+     * tesselation.
+     *
+     * @param aSource is the layer to copy the contours from; it is not modified
+     *
+     * @return bool: true if the contours were added
+     */
+    bool AppendContours( const VRML_LAYER& aSource );
+
     /**
      * Function EnsureWinding
      * checks the winding of a contour and ensures that it is a hole or
@@ -35,6 +35,7 @@
 #include "kicad2step_frame_base.h"
 #include "panel_kicad2step.h"
 #include <Standard_Failure.hxx>     // In open cascade
+#include <profile.h>
 
 class KICAD2STEP_FRAME;
 
@@ -75,6 +76,7 @@ KICAD2MCAD_PRMS::KICAD2MCAD_PRMS()
     m_useGridOrigin = false;
     m_useDrillOrigin = false;
     m_includeVirtual = true;
+    m_verbose = false;
     m_xOrigin = 0.0;
     m_yOrigin = 0.0;
     m_minDistance = MIN_DISTANCE;
@@ -114,6 +116,8 @@ static const wxCmdLineEntryDesc cmdLineDesc[] =
         { wxCMD_LINE_OPTION, NULL, "min-distance",
             _( "Minimum distance between points to treat them as separate ones (default 0.01 mm)" ).mb_str(),
             wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+        { wxCMD_LINE_SWITCH, "v", "verbose", _( "report the time spent in each export phase" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
         { wxCMD_LINE_SWITCH, "h", NULL, _( "display this message" ).mb_str(),
             wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
         { wxCMD_LINE_NONE }
@@ -204,6 +208,9 @@ bool KICAD2MCAD_APP::OnCmdLineParsed( wxCmdLineParser& parser )
     if( parser.Found( "no-virtual" ) )
         m_params.m_includeVirtual = false;
 
+    if( parser.Found( "v" ) )
+        m_params.m_verbose = true;
+
     wxString tstr;
 
     if( parser.Found( "user-origin", &tstr ) )
@@ -364,6 +371,7 @@ int PANEL_KICAD2STEP::RunConverter()
 
     pcb.SetOrigin( m_params.m_xOrigin, m_params.m_yOrigin );
     pcb.SetMinDistance( m_params.m_minDistance );
+    pcb.SetVerbose( m_params.m_verbose );
     ReportMessage( wxString::Format( "Read: %s\n", m_params.m_filename ) );
 
     // create the new streams to "redirect" cout and cerr output to
@@ -390,6 +398,8 @@ int PANEL_KICAD2STEP::RunConverter()
             pcb.ComposePCB( m_params.m_includeVirtual );
             ReportMessage( "Write STEP file\n" );
 
+            PROF_COUNTER writeTimer;
+
         #ifdef SUPPORTS_IGES
             if( m_fmtIGES )
                 res = pcb.WriteIGES( outfile );
@@ -402,6 +412,10 @@ int PANEL_KICAD2STEP::RunConverter()
                 wxMessageBox( "Error Write STEP file" );
                 return -1;
             }
+
+            if( m_params.m_verbose )
+                ReportMessage( wxString::Format( "Write STEP file: %.0f ms\n",
+                                                 writeTimer.msecs() ) );
         }
         catch( const Standard_Failure& e )
         {
@@ -26,6 +26,7 @@
 #include "kicadcurve.h"
 #include "kicadmodule.h"
 #include "oce_utils.h"
+#include <profile.h>
 
 #include <sexpr/sexpr.h>
 #include <sexpr/sexpr_parser.h>
@@ -94,6 +95,7 @@ KICADPCB::KICADPCB()
     m_thickness = 1.6;
     m_pcb_model = nullptr;
     m_minDistance = MIN_DISTANCE;
+    m_verbose = false;
     m_useGridOrigin = false;
     m_useDrillOrigin = false;
     m_hasGridOrigin = false;
@@ -449,9 +451,25 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual )
         m_pcb_model->AddOutlineSegment( &lcurve );
     }
 
+    // read all the component models up front; this is the slow part of the export
+    PROF_COUNTER timer;
+    std::vector< std::string > modelFiles;
+
+    for( auto i : m_modules )
+        i->GetModelFiles( &m_resolver, modelFiles, aComposeVirtual );
+
+    size_t modelCount = m_pcb_model->LoadModels( modelFiles );
+
+    if( m_verbose )
+        ReportMessage( wxString::Format( "Read %d model files: %.0f ms\n",
+                                         (int) modelCount, timer.msecs( true ) ) );
+
     for( auto i : m_modules )
         i->ComposePCB( m_pcb_model, &m_resolver, origin, aComposeVirtual );
 
+    if( m_verbose )
+        ReportMessage( wxString::Format( "Place components: %.0f ms\n", timer.msecs( true ) ) );
+
     ReportMessage( "Create PCB solid model\n" );
 
     if( !m_pcb_model->CreatePCB() )
@@ -462,5 +480,9 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual )
         return false;
     }
 
+    if( m_verbose )
+        ReportMessage( wxString::Format( "Create PCB solid model: %.0f ms\n",
+                                         timer.msecs( true ) ) );
+
     return true;
 }
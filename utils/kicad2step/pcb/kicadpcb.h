@@ -66,6 +66,8 @@ private:
     bool        m_hasDrillOrigin;
     // minimum distance between points to treat them as separate entities (mm)
     double      m_minDistance;
+    // report the time spent in each export phase
+    bool        m_verbose;
     // the names of layers in use, and the internal layer ID
     std::map<std::string, int> m_layersNames;
 
@@ -108,6 +110,11 @@ public:
         m_minDistance = aDistance;
     }
 
+    void SetVerbose( bool aVerbose )
+    {
+        m_verbose = aVerbose;
+    }
+
     bool ReadFile( const wxString& aFileName );
     bool ComposePCB( bool aComposeVirtual = true );
     bool WriteSTEP( const wxString& aFileName );
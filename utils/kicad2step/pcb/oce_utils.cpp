@@ -22,9 +22,13 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <wx/wx.h>
 #include <wx/filename.h>
@@ -43,6 +47,7 @@
 #include <Quantity_Color.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
+#include <STEPControl_Controller.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
 #include <Standard_Version.hxx>
 #include <TCollection_ExtendedString.hxx>
@@ -88,6 +93,14 @@ static constexpr double BOARD_OFFSET = 0.05;
 // min. length**2 below which 2 points are considered coincident
 static constexpr double MIN_LENGTH2 = MIN_DISTANCE * MIN_DISTANCE;
 
+// Older OCC/OCE translators keep per-read state in shared statics, so model
+// files are only read concurrently on releases where the readers are reentrant
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070600 )
+static constexpr bool PARALLEL_MODEL_READS = true;
+#else
+static constexpr bool PARALLEL_MODEL_READS = false;
+#endif
+
 static void getEndPoints( const KICADCURVE& aCurve, double& spx0, double& spy0,
     double& epx0, double& epy0 )
 {
@@ -215,6 +228,104 @@ FormatType fileType( const char* aFileName )
 }
 
 
+// list the existing MCAD replacements of a .wrl model, in order of preference
+static void getAltModelFiles( const std::string& aFileName, std::vector<std::string>& aAltFiles )
+{
+    wxFileName wrlName( aFileName );
+
+    wxString basePath = wrlName.GetPath();
+    wxString baseName = wrlName.GetName();
+
+    // List of alternate files to look for
+    // Given in order of preference
+    wxArrayString alts;
+
+    // Step files
+    alts.Add( "stp" );
+    alts.Add( "step" );
+    alts.Add( "STP" );
+    alts.Add( "STEP" );
+    alts.Add( "Stp" );
+    alts.Add( "Step" );
+
+    // IGES files
+    alts.Add( "iges" );
+    alts.Add( "IGES" );
+    alts.Add( "igs" );
+    alts.Add( "IGS" );
+
+    //TODO - Other alternative formats?
+
+    for( const auto& alt : alts )
+    {
+        wxFileName altFile( basePath, baseName + "." + alt );
+
+        if( altFile.IsOk() && altFile.FileExists() )
+            aAltFiles.push_back( altFile.GetFullPath().ToStdString() );
+    }
+}
+
+
+// the read precision is a process-wide translator setting; the STEP and IGES
+// controllers must have been initialized before it can be set
+static bool setReadPrecision()
+{
+    // Enable user-defined shape precision
+    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+        return false;
+
+    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
+    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+        return false;
+
+    return true;
+}
+
+
+// read an IGES file into doc; only touches doc, so it may run on a worker thread
+static bool transferIGES( Handle( TDocStd_Document )& doc, const char* fname )
+{
+    IGESCAFControl_Reader reader;
+    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
+
+    if( stat != IFSelect_RetDone )
+        return false;
+
+    // set other translation options
+    reader.SetColorMode(true);  // use model colors
+    reader.SetNameMode(false);  // don't use IGES label names
+    reader.SetLayerMode(false); // ignore LAYER data
+
+    if ( !reader.Transfer( doc ) )
+        return false;
+
+    // are there any shapes to translate?
+    return reader.NbShapes() > 0;
+}
+
+
+// read a STEP file into doc; only touches doc, so it may run on a worker thread
+static bool transferSTEP( Handle( TDocStd_Document )& doc, const char* fname )
+{
+    STEPCAFControl_Reader reader;
+    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
+
+    if( stat != IFSelect_RetDone )
+        return false;
+
+    // set other translation options
+    reader.SetColorMode(true);  // use model colors
+    reader.SetNameMode(false);  // don't use label names
+    reader.SetLayerMode(false); // ignore LAYER data
+
+    if ( !reader.Transfer( doc ) )
+        return false;
+
+    // are there any shapes to translate?
+    return reader.NbRootsForTransfer() > 0;
+}
+
+
 PCBMODEL::PCBMODEL()
 {
     m_app = XCAFApp_Application::GetApplication();
@@ -236,6 +347,12 @@ PCBMODEL::PCBMODEL()
 
 PCBMODEL::~PCBMODEL()
 {
+    for( auto& modelDoc : m_modelDocs )
+    {
+        if( !modelDoc.second.IsNull() )
+            modelDoc.second->Close();
+    }
+
     m_doc->Close();
     return;
 }
@@ -564,6 +681,131 @@ bool PCBMODEL::AddPadHole( KICADPAD* aPad )
 }
 
 
+// read the model files ahead of AddComponent(), several at a time
+size_t PCBMODEL::LoadModels( const std::vector< std::string >& aFileNames )
+{
+    struct MODEL_READ
+    {
+        std::string                 fileName;
+        FormatType                  format;
+        Handle( TDocStd_Document )  doc;
+        bool                        success;
+    };
+
+    std::vector< MODEL_READ > reads;
+
+    // Documents are created and registered with the application here, on the
+    // main thread; the workers below only fill their own document
+    for( const std::string& name : aFileNames )
+    {
+        // missing files are reported later by getModelLabel()
+        if( !wxFileName::FileExists( wxString::FromUTF8Unchecked( name.c_str() ) ) )
+            continue;
+
+        std::string fileName = name;
+        FormatType  format = fileType( fileName.c_str() );
+
+        // a .wrl model stands for its preferred MCAD replacement
+        if( FMT_WRL == format )
+        {
+            std::vector<std::string> altFiles;
+            getAltModelFiles( fileName, altFiles );
+
+            if( altFiles.empty() )
+                continue;
+
+            fileName = altFiles.front();
+            format = fileType( fileName.c_str() );
+        }
+
+        if( ( FMT_STEP != format && FMT_IGES != format ) || m_modelDocs.count( fileName ) )
+            continue;
+
+        Handle( TDocStd_Document ) doc;
+        m_app->NewDocument( "MDTV-XCAF", doc );
+        m_modelDocs[ fileName ] = doc;
+        reads.push_back( { fileName, format, doc, false } );
+    }
+
+    if( reads.empty() )
+        return 0;
+
+    // The translator controllers and the read precision are global; set them up
+    // once so that no reader needs to touch them while others are running
+    STEPControl_Controller::Init();
+    IGESControl_Controller::Init();
+
+    if( !setReadPrecision() )
+        return 0;
+
+    std::atomic<size_t> nextItem( 0 );
+    size_t              parallelThreadCount = PARALLEL_MODEL_READS ?
+            std::min<size_t>( std::thread::hardware_concurrency(), reads.size() ) : 1;
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto read_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextItem++; i < reads.size(); i = nextItem++ )
+        {
+            MODEL_READ& read = reads[i];
+
+            try
+            {
+                if( FMT_IGES == read.format )
+                    read.success = transferIGES( read.doc, read.fileName.c_str() );
+                else
+                    read.success = transferSTEP( read.doc, read.fileName.c_str() );
+            }
+            catch( const Standard_Failure& )
+            {
+                read.success = false;
+            }
+
+            if( read.success )
+                num++;
+        }
+
+        return num;
+    };
+
+    size_t loaded = 0;
+
+    if( parallelThreadCount <= 1 )
+        loaded = read_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, read_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // keep the message panel responsive while the models are read
+            while( returns[ii].wait_for( std::chrono::milliseconds( 100 ) )
+                   != std::future_status::ready )
+            {
+                wxSafeYield();
+            }
+
+            loaded += returns[ii].get();
+        }
+    }
+
+    // failed reads are kept as null documents so getModelLabel() reports them
+    for( MODEL_READ& read : reads )
+    {
+        if( !read.success )
+        {
+            read.doc->Close();
+            m_modelDocs[ read.fileName ].Nullify();
+        }
+    }
+
+    return loaded;
+}
+
+
 // add a component at the given position and orientation
 bool PCBMODEL::AddComponent( const std::string& aFileName, const std::string& aRefDes,
     bool aBottom, DOUBLET aPosition, double aRotation,
@@ -790,6 +1032,9 @@ bool PCBMODEL::CreatePCB()
              holelist.Append( hole );
 
         Cut.SetTools( holelist );
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070000 )
+        Cut.SetRunParallel( Standard_True );
+#endif
         Cut.Build();
         board = Cut.Shape();
     }
@@ -922,15 +1167,22 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
 
     aLabel.Nullify();
 
+    // use the document read by LoadModels(), if any; a null one means the read failed
     Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
+    MODEL_DOC_MAP::const_iterator md = m_modelDocs.find( aFileName );
+    bool preloaded = md != m_modelDocs.end();
+
+    if( preloaded )
+        doc = md->second;
+    else
+        m_app->NewDocument( "MDTV-XCAF", doc );
 
     FormatType modelFmt = fileType( aFileName.c_str() );
 
     switch( modelFmt )
     {
         case FMT_IGES:
-            if( !readIGES( doc, aFileName.c_str() ) )
+            if( preloaded ? doc.IsNull() : !readIGES( doc, aFileName.c_str() ) )
             {
                 ReportMessage( wxString::Format( "readIGES() failed on filename %s\n",
                                aFileName ) );
@@ -939,7 +1191,7 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
             break;
 
         case FMT_STEP:
-            if( !readSTEP( doc, aFileName.c_str() ) )
+            if( preloaded ? doc.IsNull() : !readSTEP( doc, aFileName.c_str() ) )
             {
                 ReportMessage( wxString::Format( "readSTEP() failed on filename %s\n",
                                aFileName ) );
@@ -960,45 +1212,14 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
              *
              */
             {
-                wxFileName wrlName( aFileName );
-
-                wxString basePath = wrlName.GetPath();
-                wxString baseName = wrlName.GetName();
+                std::vector<std::string> altFiles;
+                getAltModelFiles( aFileName, altFiles );
 
-                // List of alternate files to look for
-                // Given in order of preference
                 // (Break if match is found)
-                wxArrayString alts;
-
-                // Step files
-                alts.Add( "stp" );
-                alts.Add( "step" );
-                alts.Add( "STP" );
-                alts.Add( "STEP" );
-                alts.Add( "Stp" );
-                alts.Add( "Step" );
-
-                // IGES files
-                alts.Add( "iges" );
-                alts.Add( "IGES" );
-                alts.Add( "igs" );
-                alts.Add( "IGS" );
-
-                //TODO - Other alternative formats?
-
-                for( const auto& alt : alts )
+                for( const std::string& altFileName : altFiles )
                 {
-                    wxFileName altFile( basePath, baseName + "." + alt );
-
-                    if( altFile.IsOk() && altFile.FileExists() )
-                    {
-                        std::string altFileName = altFile.GetFullPath().ToStdString();
-
-                        if( getModelLabel( altFileName, aScale, aLabel ) )
-                        {
-                            return true;
-                        }
-                    }
+                    if( getModelLabel( altFileName, aScale, aLabel ) )
+                        return true;
                 }
             }
 
@@ -1090,33 +1311,11 @@ bool PCBMODEL::getModelLocation( bool aBottom, DOUBLET aPosition, double aRotati
 bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 {
     IGESControl_Controller::Init();
-    IGESCAFControl_Reader reader;
-    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
-
-    if( stat != IFSelect_RetDone )
-        return false;
-
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
 
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+    if( !setReadPrecision() )
         return false;
 
-    // set other translation options
-    reader.SetColorMode(true);  // use model colors
-    reader.SetNameMode(false);  // don't use IGES label names
-    reader.SetLayerMode(false); // ignore LAYER data
-
-    if ( !reader.Transfer( doc ) )
-    {
-        doc->Close();
-        return false;
-    }
-
-    // are there any shapes to translate?
-    if( reader.NbShapes() < 1 )
+    if( !transferIGES( doc, fname ) )
     {
         doc->Close();
         return false;
@@ -1128,33 +1327,12 @@ bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 
 bool PCBMODEL::readSTEP( Handle(TDocStd_Document)& doc, const char* fname )
 {
-    STEPCAFControl_Reader reader;
-    IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
-
-    if( stat != IFSelect_RetDone )
-        return false;
-
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
-    // set other translation options
-    reader.SetColorMode(true);  // use model colors
-    reader.SetNameMode(false);  // don't use label names
-    reader.SetLayerMode(false); // ignore LAYER data
+    STEPControl_Controller::Init();
 
-    if ( !reader.Transfer( doc ) )
-    {
-        doc->Close();
+    if( !setReadPrecision() )
         return false;
-    }
 
-    // are there any shapes to translate?
-    if( reader.NbRootsForTransfer() < 1 )
+    if( !transferSTEP( doc, fname ) )
     {
         doc->Close();
         return false;
@@ -43,6 +43,7 @@
 
 typedef std::pair< std::string, TDF_Label > MODEL_DATUM;
 typedef std::map< std::string, TDF_Label > MODEL_MAP;
+typedef std::map< std::string, Handle( TDocStd_Document ) > MODEL_DOC_MAP;
 
 class KICADPAD;
 
@@ -88,6 +89,7 @@ class PCBMODEL
     bool                            m_hasPCB;       // set true if CreatePCB() has been invoked
     TDF_Label                       m_pcb_label;    // label for the PCB model
     MODEL_MAP                       m_models;       // map of file names to model labels
+    MODEL_DOC_MAP                   m_modelDocs;    // model files read ahead by LoadModels()
     int                             m_components;   // number of successfully loaded components;
     double                          m_precision;    // model (length unit) numeric precision
     double                          m_angleprec;    // angle numeric precision
@@ -120,6 +122,10 @@ public:
     // add a pad hole or slot (must be in final position)
     bool AddPadHole( KICADPAD* aPad );
 
+    // read the STEP/IGES files behind the given model names concurrently so that
+    // AddComponent() only has to transfer them; returns the number of files read
+    size_t LoadModels( const std::vector< std::string >& aFileNames );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes,
         bool aBottom, DOUBLET aPosition, double aRotation,